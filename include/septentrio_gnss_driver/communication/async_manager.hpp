@@ -66,8 +66,19 @@
 #include <boost/system/error_code.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#if defined(__linux__)
+// For the batched multi-datagram receives (recvmmsg) of the UDP transport
+#include <sys/socket.h>
+// For the SIOCGSTAMPNS ioctl retrieving the kernel receive timestamp of the last ingested packet
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+#endif
+
 // ROSaic includes
-#include <septentrio_gnss_driver/communication/circular_buffer.hpp>
+#include <septentrio_gnss_driver/communication/spsc_ring_buffer.hpp>
+#include <septentrio_gnss_driver/communication/raw_capture.hpp>
+#include <septentrio_gnss_driver/communication/pipeline_stats.hpp>
+#include <septentrio_gnss_driver/communication/thread_tuning.hpp>
 
 #ifndef ASYNC_MANAGER_HPP
 #define ASYNC_MANAGER_HPP
@@ -89,10 +100,13 @@ namespace io_comm_rx
 	 */
 	class Manager {
 		public:
-			typedef boost::function<void(const uint8_t*, std::size_t&)> Callback;
+			typedef boost::function<void(const uint8_t*, std::size_t&, const ros::Time&)> Callback;
+			typedef boost::function<void()> ConnectionLostCallback;
 			virtual ~Manager() {}
 			//! Sets the callback function
 			virtual void setCallback(const Callback& callback) = 0;
+			//! Sets the callback function to be called once the connection to the Rx is irrecoverably lost
+			virtual void setConnectionLostCallback(const ConnectionLostCallback& callback) = 0;
 			//! Sends commands to the receiver
 			virtual bool send(std::string cmd, std::size_t size) = 0;
 			//! Waits count seconds before throwing ROS_INFO message in case no message from the receiver arrived
@@ -102,11 +116,34 @@ namespace io_comm_rx
 	};
 
 
+	//! Tag type marking StreamT as a stream-oriented transport (serial port or TCP socket)
+	struct StreamTransportTag {};
+
+	//! Tag type marking StreamT as a datagram-oriented transport (UDP socket)
+	struct DatagramTransportTag {};
+
+	/**
+	 * @class TransportTraits
+	 * @brief Maps each StreamT onto its transport tag, s.t. the AsyncManager class can pick between its
+	 * stream-oriented and its datagram-oriented read and write paths at compile time
+	 */
+	template <typename StreamT>
+	struct TransportTraits
+	{
+		typedef StreamTransportTag Tag;
+	};
+
+	template <>
+	struct TransportTraits<boost::asio::ip::udp::socket>
+	{
+		typedef DatagramTransportTag Tag;
+	};
+
 	/**
 	 * @class AsyncManager
 	 * @brief This is the central interface between ROSaic and the Rx(s), managing I/O operations such as reading messages and sending commands..
-	 * 
-	 * StreamT is either boost::asio::serial_port or boost::asio::tcp::ip
+	 *
+	 * StreamT is either boost::asio::serial_port, boost::asio::tcp::ip or boost::asio::ip::udp::socket
 	 */
 	template <typename StreamT>
 	class AsyncManager : public Manager 
@@ -115,13 +152,21 @@ namespace io_comm_rx
 			/**
 			 * @brief Class constructor
 			 * @param stream Whether TCP/IP or serial communication, either boost::asio::serial_port or boost::asio::tcp::ip
-			 * @param io_service The io_context object. The io_context represents your program's link to the operating system's I/O services. 
+			 * @param io_service The io_context object. The io_context represents your program's link to the operating system's I/O services.
+			 * @param shared_io_service Whether io_service is a shared one whose run() is already being invoked
+			 * by an external thread pool (cf. Comm_IO::startIOThreadPool()), in which case no dedicated I/O
+			 * thread is spawned here
+			 * @param read_batching_us Ingest latency budget in microseconds the reader may spend waiting for
+			 * further bytes to accumulate after a small read, s.t. a trickling stream is ingested in fewer,
+			 * larger reads; 0 (the default) re-posts the next read immediately
 			 */
-			AsyncManager(boost::shared_ptr<StreamT> stream, boost::shared_ptr<boost::asio::io_service> io_service, std::size_t buffer_size = 8192);
+			AsyncManager(boost::shared_ptr<StreamT> stream, boost::shared_ptr<boost::asio::io_service> io_service, std::size_t buffer_size = 8192, std::size_t ring_capacity = 65536, bool shared_io_service = false, std::size_t read_batching_us = 0);
 			virtual ~AsyncManager();
 	 
 			void setCallback(const Callback& callback) { read_callback_ = callback; }
-	 	 
+
+			void setConnectionLostCallback(const ConnectionLostCallback& callback) { connection_lost_callback_ = callback; }
+
 			void wait(uint16_t* count);
 			
 			/**
@@ -135,53 +180,116 @@ namespace io_comm_rx
 			
 		protected:
 			
-			//! Reads in via async_read_some and hands certain number of bytes (bytes_transferred) over to async_read_some_handler 
+			//! Reads in via async_read_some and hands certain number of bytes (bytes_transferred) over to async_read_some_handler
 			void read();
-			
+
+			//! Stream-oriented read path of read(), cf. the TransportTraits class
+			void doRead(StreamTransportTag);
+
+			//! Datagram-oriented read path of read(): merely posts a readiness wait, the actual draining
+			//! happens in drainDatagrams()
+			void doRead(DatagramTransportTag);
+
 			//!  Handler for async_read_some (Boost library)..
 			void asyncReadSomeHandler(const boost::system::error_code& error, std::size_t bytes_transferred);
-			
+
+			//! Handler for the readiness wait posted by the datagram-oriented read path
+			void datagramReadyHandler(const boost::system::error_code& error);
+
+			//! Handler for the batching timer: the latency budget has elapsed, the deferred read is posted
+			void batchTimerHandler(const boost::system::error_code& error);
+
+			//! Drains the readable datagram socket into the ring buffer with batched multi-datagram receives
+			void drainDatagrams();
+
+			//! Returns the wire-arrival time of the bytes just ingested: the kernel receive timestamp of the
+			//! last packet where the transport offers one (Linux sockets), the current time otherwise
+			ros::Time captureIngestStamp();
+
+			//! Appends (total ring bytes written so far, stamp) to the ingest stamp journal (I/O thread only)
+			void recordIngestStamp(const ros::Time& stamp);
+
+			//! Pops all journal entries covered by the given monotonic ring read offset and returns the stamp
+			//! of the newest one, i.e. the arrival time of the burst that completed the chunk about to be
+			//! parsed (parser thread only)
+			ros::Time popIngestStamp(std::size_t parsed_end);
+
 			//! Sends command "cmd" to the Rx
 			void write(std::string cmd, std::size_t size);
+
+			//! Stream-oriented write path of write(), cf. the TransportTraits class
+			void doWrite(std::string cmd, std::size_t size, StreamTransportTag);
+
+			//! Datagram-oriented write path of write(): one command becomes one datagram
+			void doWrite(std::string cmd, std::size_t size, DatagramTransportTag);
 			
 			//! Closes stream "stream_"
 			void close();
 			
-			//! Tries parsing SBF/NMEA whenever the boolean class variable "try_parsing" is true
+			//! Tries parsing SBF/NMEA whenever the ring buffer holds unread bytes
 			void tryParsing();
-			
-			//! Mutex to control changes of class variable "try_parsing"
+
+			//! Mutex solely used to park the parser thread while the ring buffer is empty
 			boost::mutex parse_mutex_;
-			
-			//! Determines when the tryParsing() method will attempt parsing SBF/NMEA
-			bool try_parsing_;
-			
-			//! Determines when the asyncReadSomeHandler() method should write SBF/NMEA into the circular buffer
-			bool allow_writing_;
-			
-			//! Condition variable complementing "parse_mutex"
+
+			//! Condition variable complementing "parse_mutex"; the I/O thread only ever calls notify_one() on it,
+			//! it never waits, s.t. the reader makes progress irrespective of how far the parser lags behind
 			boost::condition_variable parsing_condition_;
-			
+
 			//! Stream, represents either serial or TCP/IP connection
-			boost::shared_ptr<StreamT> stream_; 
-			
+			boost::shared_ptr<StreamT> stream_;
+
 			//! io_context object
-			boost::shared_ptr<boost::asio::io_service> io_service_; 
-			
+			boost::shared_ptr<boost::asio::io_service> io_service_;
+
 			//! Buffer for async_read_some() to read continuous SBF/NMEA stream
-			std::vector<uint8_t> in_; 
-			
-			//! Circular buffer to avoid unsuccessful SBF/NMEA parsing due to incomplete messages 
-			CircularBuffer circular_buffer_; 
+			std::vector<uint8_t> in_;
+
+			//! Scratch buffer the batched multi-datagram receives scatter into, one MAX_DATAGRAM_SIZE_
+			//! slot per datagram of a batch; remains empty on stream-oriented transports
+			std::vector<uint8_t> datagram_scratch_;
+
+			//! Upper bound on the number of datagrams ingested per batched receive, i.e. per syscall
+			static const std::size_t DATAGRAM_BATCH_ = 32;
+
+			//! Upper bound on the payload size of a single datagram, generously above both the usual
+			//! Ethernet MTU and the size of the largest SBF blocks
+			static const std::size_t MAX_DATAGRAM_SIZE_ = 2048;
+
+			//! Lock-free SPSC ring buffer decoupling the ASIO reader (producer) from the parser thread (consumer),
+			//! avoiding unsuccessful SBF/NMEA parsing due to incomplete messages
+			SPSCRingBuffer ring_buffer_;
+
+			//! First of the two pre-allocated staging buffers that tryParsing() ping-pongs between
+			std::vector<uint8_t> parse_buffer_a_;
+
+			//! Second of the two pre-allocated staging buffers that tryParsing() ping-pongs between
+			std::vector<uint8_t> parse_buffer_b_;
 			
 			//! Memory location where read_callback_ will start reading unless part of SBF/NMEA had to be appended before
-			uint8_t * to_be_parsed_;
+			const uint8_t * to_be_parsed_;
+
+			//! Whether the currently outstanding async_read_some() deposits directly into the ring's write region
+			bool reading_into_ring_;
 			
-			//! New thread for receiving incoming messages
-			boost::shared_ptr<boost::thread> async_background_thread_; 
+			//! New thread for receiving incoming messages; remains empty in case the io_service is a shared
+			//! one run by an external thread pool
+			boost::shared_ptr<boost::thread> async_background_thread_;
 			
 			//! Callback to be called once message arrives
-			Callback read_callback_; 
+			Callback read_callback_;
+
+			//! Callback to be called once the connection is irrecoverably lost, cf. the reconnect engine
+			//! of the Comm_IO class
+			ConnectionLostCallback connection_lost_callback_;
+
+			//! The tryParsing() thread, joined in the destructor s.t. an AsyncManager of a severed stream
+			//! can be torn down and replaced by a fresh one
+			boost::shared_ptr<boost::thread> parse_thread_;
+
+			//! Lossless raw capture of this stream's bytes, empty unless enabled via the raw_capture/..
+			//! ROS parameters
+			boost::shared_ptr<RawCapture> raw_capture_;
 			
 			//! Whether or not we want to sever the connection to the Rx
 			bool stopping_; 
@@ -189,6 +297,38 @@ namespace io_comm_rx
 			/// Size of in_ buffers
 			const std::size_t buffer_size_;
 			
+			//! Ingest latency budget in microseconds the reader may spend waiting for further bytes to
+			//! accumulate after a small read, cf. the constructor; 0 disables the batching
+			const std::size_t read_batching_us_;
+
+			//! Timer deferring the re-post of the next read while the batching budget elapses
+			boost::asio::deadline_timer batch_timer_;
+
+			//! One entry of the ingest stamp journal: all ring bytes up to (and including) the monotonic
+			//! write offset ring_offset arrived no later than stamp
+			struct IngestStamp
+			{
+				std::size_t ring_offset;
+				ros::Time stamp;
+			};
+
+			//! Capacity of the ingest stamp journal, a power of two; one entry is recorded per ingest burst,
+			//! hence the journal only ever fills up while the parser lags dozens of bursts behind
+			static const std::size_t STAMP_JOURNAL_SIZE_ = 64;
+
+			//! SPSC journal carrying the per-burst arrival stamps from the I/O thread to the parser thread
+			//! alongside the ring buffer, cf. the IngestStamp struct; indexed like the ring's own head/tail
+			IngestStamp stamp_journal_[STAMP_JOURNAL_SIZE_];
+
+			//! Monotonically increasing journal write index, only ever advanced by the I/O thread
+			std::atomic<std::size_t> stamp_head_;
+
+			//! Monotonically increasing journal read index, only ever advanced by the parser thread
+			std::atomic<std::size_t> stamp_tail_;
+
+			//! Newest stamp popped off the journal so far (parser thread only), handed to the read callback
+			ros::Time last_ingest_stamp_;
+
 			//! Boost timer for throwing ROS_INFO message once timed out due to lack of incoming messages
 			boost::asio::deadline_timer timer_;
 			
@@ -206,57 +346,103 @@ namespace io_comm_rx
 	template <typename StreamT>
 	void AsyncManager<StreamT>::tryParsing()
 	{
-		uint8_t * to_be_parsed;
-		to_be_parsed = new uint8_t[buffer_size_];
-		to_be_parsed_ = to_be_parsed;
-		bool timed_out = false;
-		std::size_t shift_bytes = 0;
-		std::size_t arg_for_read_callback = 0;
-		
-		while(!timed_out) // Loop will stop if condition variable timed out
+		// The two staging buffers are allocated once (in the constructor) and then ping-ponged below, s.t. the
+		// steady-state hot path performs zero heap allocations, however many chunks are parsed per second.
+		uint8_t * active = parse_buffer_a_.data();
+		uint8_t * spare = parse_buffer_b_.data();
+		to_be_parsed_ = active;
+		std::size_t unparsed_bytes = 0; // Bytes of an incomplete message carried over from the previous attempt
+
+		while(true) // Loop will stop if condition variable timed out
 		{
-			boost::mutex::scoped_lock lock(parse_mutex_);
-			parsing_condition_.wait_for(lock, boost::chrono::seconds(10), [this](){return try_parsing_;});
-			bool timed_out = !try_parsing_;
+			{
+				// The lock is only ever contended while the parser is idle: the I/O thread merely calls
+				// notify_one() after publishing bytes to the (lock-free) ring buffer.
+				boost::mutex::scoped_lock lock(parse_mutex_);
+				parsing_condition_.wait_for(lock, boost::chrono::seconds(10), [this](){return stopping_ || !ring_buffer_.empty();});
+			}
+			if (stopping_) return; // The stream is being torn down, e.g. by the reconnect engine of the Comm_IO class..
+			bool timed_out = ring_buffer_.empty();
 			if (timed_out) break;
-			try_parsing_ = false;
-			allow_writing_ = true;
-			std::size_t current_buffer_size = circular_buffer_.size();
-			arg_for_read_callback += current_buffer_size;
-			circular_buffer_.read(to_be_parsed + shift_bytes, current_buffer_size);
-			
-			lock.unlock();
-			parsing_condition_.notify_one();
-			
+
+			// Forced resync hint of the drop-oldest overflow policy: the producer evicted the oldest
+			// unread bytes (cf. SPSCRingBuffer::write()), hence whatever incomplete message was carried
+			// over lost its remainder. It is discarded here s.t. the scanner re-synchronizes at the next
+			// sync pair of the surviving (newest) bytes - one epoch of degradation rather than the long
+			// byte-wise hunt through stale garbage an unannounced cut used to cause. An eviction may
+			// also race with the parse of the current chunk, whose frames then fail their CRC checks;
+			// the flag, still set, is honored on the next pass.
+			if (ring_buffer_.consumeOverflowFlag())
+			{
+				unparsed_bytes = 0;
+				to_be_parsed_ = active;
+			}
+
+			// Zero-copy fast path: without carried-over bytes the parser can decode in place from the ring's
+			// read region, copying into a staging buffer only the (rare) chunks that straddle the wrap point
+			// or leave an incomplete message behind.
+			if (unparsed_bytes == 0)
+			{
+				std::size_t read_pos = ring_buffer_.totalRead();
+				std::size_t contiguous = ring_buffer_.contiguousSize();
+				std::size_t arg_for_read_callback = contiguous;
+				to_be_parsed_ = ring_buffer_.readPtr();
+				// The stamp of the burst that completed this chunk: frames are thereby stamped with the
+				// arrival time of their last byte, irrespective of how long parsing and decoding take.
+				ros::Time ingest_stamp = popIngestStamp(read_pos + contiguous);
+				try
+				{
+					ROS_DEBUG("Calling read_callback_() method in place, with number of bytes to be parsed being %li",
+						arg_for_read_callback);
+					read_callback_(to_be_parsed_, arg_for_read_callback, ingest_stamp);
+				}
+				catch (std::size_t& parsing_failed_here)
+				{
+					// The incomplete message is copied out of the ring into the staging buffer, after which
+					// the whole contiguous region can be released to the producer.
+					unparsed_bytes = arg_for_read_callback - parsing_failed_here;
+					if (unparsed_bytes >= ring_buffer_.capacity()) unparsed_bytes = 0;
+					else memcpy(active, to_be_parsed_ + parsing_failed_here, unparsed_bytes);
+					to_be_parsed_ = active;
+					ring_buffer_.consumeTo(read_pos + contiguous);
+					continue;
+				}
+				ring_buffer_.consumeTo(read_pos + contiguous);
+				continue;
+			}
+
+			std::size_t current_buffer_size = ring_buffer_.read(active + unparsed_bytes,
+				ring_buffer_.capacity() - unparsed_bytes);
+			std::size_t arg_for_read_callback = unparsed_bytes + current_buffer_size;
+			ros::Time ingest_stamp = popIngestStamp(ring_buffer_.totalRead());
+
 			try
 			{
-				ROS_DEBUG("Calling read_callback_() method, with number of bytes to be parsed being %li", 
+				ROS_DEBUG("Calling read_callback_() method, with number of bytes to be parsed being %li",
 					arg_for_read_callback);
-				read_callback_(to_be_parsed_, arg_for_read_callback);
+				read_callback_(to_be_parsed_, arg_for_read_callback, ingest_stamp);
 			}
-			catch (std::size_t& parsing_failed_here) 
+			catch (std::size_t& parsing_failed_here)
 			{
-				to_be_parsed_ = to_be_parsed + parsing_failed_here;
-				ROS_DEBUG("Current buffer size is %li and parsing_failed_here is %li", current_buffer_size, 
+				ROS_DEBUG("Current buffer size is %li and parsing_failed_here is %li", current_buffer_size,
 					parsing_failed_here);
-				arg_for_read_callback = arg_for_read_callback - parsing_failed_here;
-				if (arg_for_read_callback < 0) // In case some parsing error was not caught, which should never happen..
+				unparsed_bytes = arg_for_read_callback - parsing_failed_here;
+				if (unparsed_bytes >= ring_buffer_.capacity())
+				// In case some parsing error was not caught or an (unparsable) message never completes,
+				// which should never happen..
 				{
-					delete [] to_be_parsed; // Freeing memory
-					to_be_parsed = new uint8_t[buffer_size_];
-					to_be_parsed_ = to_be_parsed;
-					shift_bytes = 0;
-					arg_for_read_callback = 0;
+					unparsed_bytes = 0;
 					continue;
 				}
-				shift_bytes += current_buffer_size;
+				// Moves the incomplete message to the front of the spare buffer and swaps the two buffers,
+				// instead of allocating a fresh buffer as was done previously.
+				memcpy(spare, active + parsing_failed_here, unparsed_bytes);
+				std::swap(active, spare);
+				to_be_parsed_ = active;
 				continue;
 			}
-			delete [] to_be_parsed; // Freeing memory
-			to_be_parsed = new uint8_t[buffer_size_];
-			to_be_parsed_ = to_be_parsed;
-			shift_bytes = 0;
-			arg_for_read_callback = 0;
+			unparsed_bytes = 0;
+			to_be_parsed_ = active;
 		}
 		ROS_INFO("TryParsing() method finished since it did not receive anything to parse for 10 seconds..");
 	}
@@ -279,13 +465,36 @@ namespace io_comm_rx
 	}
 	
 	template <typename StreamT>
-	void AsyncManager<StreamT>::write(std::string cmd, std::size_t size) 
+	void AsyncManager<StreamT>::write(std::string cmd, std::size_t size)
+	{
+		doWrite(cmd, size, typename TransportTraits<StreamT>::Tag());
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::doWrite(std::string cmd, std::size_t size, StreamTransportTag)
 	{
 		boost::asio::write(*stream_, boost::asio::buffer(cmd.data(), size));
 		// Prints the data that was sent
 		ROS_DEBUG("Sent the following %li bytes to the Rx: \n%s", size, cmd.c_str());
 	}
 
+	template <typename StreamT>
+	void AsyncManager<StreamT>::doWrite(std::string cmd, std::size_t size, DatagramTransportTag)
+	{
+		// One command becomes one datagram. Note that send() presupposes a connected socket, i.e. a
+		// unicast stream whose sender was specified: a multicast (or wildcard) listener has nobody
+		// definite to talk to, hence the failure is reported rather than escalated.
+		try
+		{
+			stream_->send(boost::asio::buffer(cmd.data(), size));
+			ROS_DEBUG("Sent the following %li bytes to the Rx: \n%s", size, cmd.c_str());
+		}
+		catch (boost::system::system_error& e)
+		{
+			ROS_ERROR("Could not send over the UDP socket (is the stream a listen-only one?): %s", e.what());
+		}
+	}
+
 	template <typename StreamT>
 	void AsyncManager<StreamT>::callAsyncWait(uint16_t* count)
 	{
@@ -295,82 +504,325 @@ namespace io_comm_rx
 	template <typename StreamT>
 	AsyncManager<StreamT>::AsyncManager(boost::shared_ptr<StreamT> stream,
 			boost::shared_ptr<boost::asio::io_service> io_service,
-			std::size_t buffer_size) : timer_(*(io_service.get()), boost::posix_time::seconds(1)), 
-			stopping_(false), try_parsing_(false), allow_writing_(true), do_read_count_(0), buffer_size_(buffer_size), 
-			count_max_(6), circular_buffer_(buffer_size) 
-			// Since buffer_size = 8912 in declaration, no need in definition any more (even yields error message, 
+			std::size_t buffer_size, std::size_t ring_capacity, bool shared_io_service,
+			std::size_t read_batching_us) : timer_(*(io_service.get()), boost::posix_time::seconds(1)),
+			stopping_(false), reading_into_ring_(false), do_read_count_(0), buffer_size_(buffer_size),
+			count_max_(6), ring_buffer_(ring_capacity), read_batching_us_(read_batching_us),
+			batch_timer_(*(io_service.get())), stamp_head_(0), stamp_tail_(0)
+			// Since buffer_size = 8912 in declaration, no need in definition any more (even yields error message,
 			// since "overwrite").
 	{
 		ROS_DEBUG("Setting the private stream variable of the AsyncManager instance.");
 		stream_ = stream;
 		io_service_ = io_service;
 		in_.resize(buffer_size_);
-		 
+		parse_buffer_a_.resize(ring_buffer_.capacity());
+		parse_buffer_b_.resize(ring_buffer_.capacity());
+		raw_capture_ = RawCapture::createIfEnabled();
+
 		io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
 		// This function is used to ask the io_service to execute the given handler, but without allowing the io_service
-		// to call the handler from inside this function. The function signature of the handler must be: void handler(); 
-		// The io_service guarantees that the handler (given as parameter) will only be called in a thread in which the 
-		// run(), run_one(), poll() or poll_one() member functions is currently being invoked. So the fundamental 
+		// to call the handler from inside this function. The function signature of the handler must be: void handler();
+		// The io_service guarantees that the handler (given as parameter) will only be called in a thread in which the
+		// run(), run_one(), poll() or poll_one() member functions is currently being invoked. So the fundamental
 		// difference is that dispatch will execute the work right away if it can and queue it otherwise while post queues the work no matter what.
-		async_background_thread_.reset(new boost::thread(boost::bind(&boost::asio::io_service::run, io_service_))); 
-		// Note that io_service_ is already pointer, hence need dereferencing operator & (ampersand). If the value of the 
-		// pointer for the current thread is changed using reset(), then the previous value is destroyed by calling the 
-		// cleanup routine. Alternatively, the stored value can be reset to NULL and the prior value returned by calling
-		// the release() member function, allowing the application to take back responsibility for destroying the object. 
+		if (!shared_io_service)
+		{
+			async_background_thread_.reset(new boost::thread(boost::bind(&boost::asio::io_service::run, io_service_)));
+			ThreadTuning::applyIO(*async_background_thread_);
+			// Note that io_service_ is already pointer, hence need dereferencing operator & (ampersand). If the value of the
+			// pointer for the current thread is changed using reset(), then the previous value is destroyed by calling the
+			// cleanup routine. Alternatively, the stored value can be reset to NULL and the prior value returned by calling
+			// the release() member function, allowing the application to take back responsibility for destroying the object.
+		}
+		// In case of a shared io_service, its run() method is already being invoked by the threads of the pool
+		// started via Comm_IO::startIOThreadPool(), hence no thread is spawned here: the post() above suffices.
 		uint16_t count = 0;
 		boost::thread(boost::bind(&AsyncManager::callAsyncWait, this, &count));
-		
+
 		ROS_DEBUG("Launching tryParsing() thread..");
-		boost::thread(boost::bind(&AsyncManager::tryParsing, this));
-	} 	// Calls std::terminate() on thread just created
-	 
+		parse_thread_.reset(new boost::thread(boost::bind(&AsyncManager::tryParsing, this)));
+		ThreadTuning::applyParser(*parse_thread_);
+	}
+
 	template <typename StreamT>
-	AsyncManager<StreamT>::~AsyncManager() 
+	AsyncManager<StreamT>::~AsyncManager()
 	{
-		async_background_thread_->join(); 
+		// The destructor doubles as the teardown of a severed stream (cf. the reconnect engine of the
+		// Comm_IO class), hence all of the instance's threads are stopped and joined here: first the
+		// outstanding asynchronous operations are cancelled s.t. their handlers return without re-posting..
+		stopping_ = true;
+		boost::system::error_code error;
+		timer_.cancel(error);
+		batch_timer_.cancel(error);
+		stream_->close(error);
+		// ..then the parser thread is woken up (it checks stopping_ right away) and joined..
+		parsing_condition_.notify_one();
+		if (parse_thread_) parse_thread_->join();
+		// ..and finally the dedicated I/O thread, if any, is stopped. In case of a shared io_service the
+		// pool keeps running for the remaining streams, the cancellations above suffice.
+		if (async_background_thread_)
+		{
+			io_service_->stop();
+			async_background_thread_->join();
+		}
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::read()
+	{
+		doRead(typename TransportTraits<StreamT>::Tag());
 	}
 
 	template <typename StreamT>
-	void AsyncManager<StreamT>::read() 
+	void AsyncManager<StreamT>::doRead(StreamTransportTag)
 	{
-		stream_->async_read_some(
-								boost::asio::buffer(in_.data(),
-								in_.size()),
-								boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
-								boost::asio::placeholders::error,
-								boost::asio::placeholders::bytes_transferred));
-								// The handler is async_read_some_handler, whose call is postponed to 
-								// when async_read_some completes.
+		// Zero-copy fast path: let async_read_some() deposit the bytes directly into the ring's write region,
+		// sparing the in_ -> ring copy. We fall back to in_ whenever the contiguous free region has become
+		// uncomfortably small (close to the wrap point or to a full ring).
+		std::size_t contiguous_free = ring_buffer_.contiguousFree();
+		reading_into_ring_ = (read_callback_ && contiguous_free >= buffer_size_ / 2);
+		if (reading_into_ring_)
+		{
+			stream_->async_read_some(
+									boost::asio::buffer(ring_buffer_.writePtr(),
+									std::min(contiguous_free, buffer_size_)),
+									boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
+									boost::asio::placeholders::error,
+									boost::asio::placeholders::bytes_transferred));
+		}
+		else
+		{
+			stream_->async_read_some(
+									boost::asio::buffer(in_.data(),
+									in_.size()),
+									boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
+									boost::asio::placeholders::error,
+									boost::asio::placeholders::bytes_transferred));
+									// The handler is async_read_some_handler, whose call is postponed to
+									// when async_read_some completes.
+		}
 		if (do_read_count_ < 5) ++do_read_count_;
 	}
-	 
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::doRead(DatagramTransportTag)
+	{
+		// A readiness wait instead of a plain asynchronous receive: once the socket turns readable,
+		// drainDatagrams() empties it with batched multi-datagram receives, s.t. one syscall ingests a
+		// whole burst of SBF packets rather than one datagram per handler invocation.
+#if BOOST_VERSION >= 106600
+		stream_->async_wait(boost::asio::ip::udp::socket::wait_read,
+							boost::bind(&AsyncManager<StreamT>::datagramReadyHandler, this,
+							boost::asio::placeholders::error));
+#else
+		// E.g. for ROS melodic (i.e. Ubuntu 18.04) the Boost version predates async_wait(); a receive
+		// into null_buffers() completes - without consuming anything - once the socket turns readable.
+		stream_->async_receive(boost::asio::null_buffers(),
+							boost::bind(&AsyncManager<StreamT>::datagramReadyHandler, this,
+							boost::asio::placeholders::error));
+#endif
+		if (do_read_count_ < 5) ++do_read_count_;
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::datagramReadyHandler(const boost::system::error_code& error)
+	{
+		if (error)
+		{
+			if (stopping_) return; // The (expected) operation_aborted error of a stream being torn down..
+			ROS_ERROR("Rx ASIO readiness wait error: %s", error.message().c_str());
+			// Cf. asyncReadSomeHandler(): the connection-lost callback (if any) is invoked exactly once
+			// and hands over to the reconnect engine of the Comm_IO class.
+			stopping_ = true;
+			if (connection_lost_callback_) connection_lost_callback_();
+			return;
+		}
+
+		drainDatagrams();
+
+		if (!stopping_)
+			io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::drainDatagrams()
+	{
+		if (datagram_scratch_.empty()) datagram_scratch_.resize(DATAGRAM_BATCH_ * MAX_DATAGRAM_SIZE_);
+		std::size_t bytes_ingested = 0;
+		while (!stopping_)
+		{
+#if defined(__linux__)
+			// recvmmsg() pulls up to a whole batch of datagrams out of the socket in one syscall, each
+			// scattered into its own slot of the scratch buffer. Since an SBF packet is typically a few
+			// hundred bytes, a receiver burst of dozens of packets is ingested at the cost of one syscall.
+			struct mmsghdr headers[DATAGRAM_BATCH_];
+			struct iovec slots[DATAGRAM_BATCH_];
+			memset(headers, 0, sizeof(headers));
+			for (std::size_t i = 0; i < DATAGRAM_BATCH_; ++i)
+			{
+				slots[i].iov_base = datagram_scratch_.data() + i * MAX_DATAGRAM_SIZE_;
+				slots[i].iov_len = MAX_DATAGRAM_SIZE_;
+				headers[i].msg_hdr.msg_iov = &slots[i];
+				headers[i].msg_hdr.msg_iovlen = 1;
+			}
+			int received = recvmmsg(stream_->native_handle(), headers, DATAGRAM_BATCH_, MSG_DONTWAIT, NULL);
+			if (received <= 0) break; // Socket drained (EAGAIN), the caller re-posts the readiness wait
+			for (int i = 0; i < received; ++i)
+			{
+				const uint8_t* datagram = datagram_scratch_.data() +
+					static_cast<std::size_t>(i) * MAX_DATAGRAM_SIZE_;
+				std::size_t datagram_size = headers[i].msg_len;
+				if (raw_capture_) raw_capture_->append(datagram, datagram_size);
+				// The payloads are compacted back-to-back into the ring: the parser hunts for the sync
+				// bytes anyway, hence it needs no datagram boundaries.
+				if (read_callback_) ring_buffer_.write(datagram, datagram_size);
+				bytes_ingested += datagram_size;
+			}
+			if (static_cast<std::size_t>(received) < DATAGRAM_BATCH_) break; // No full batch, no backlog left
+#else
+			// Portable fallback: one non-blocking receive per datagram, still draining the whole backlog
+			// before the next readiness wait is posted.
+			boost::system::error_code receive_error;
+			stream_->non_blocking(true);
+			std::size_t datagram_size = stream_->receive(boost::asio::buffer(datagram_scratch_.data(),
+				MAX_DATAGRAM_SIZE_), 0, receive_error);
+			if (receive_error) break;
+			if (raw_capture_) raw_capture_->append(datagram_scratch_.data(), datagram_size);
+			if (read_callback_) ring_buffer_.write(datagram_scratch_.data(), datagram_size);
+			bytes_ingested += datagram_size;
+#endif
+		}
+		if (bytes_ingested > 0 && read_callback_)
+		{
+			// One lock-free handover per drained burst rather than one per datagram, cf. asyncReadSomeHandler()
+			PipelineStats::markIngest();
+			PipelineStats::recordRingOccupancy(ring_buffer_.size());
+			recordIngestStamp(captureIngestStamp());
+			parsing_condition_.notify_one();
+		}
+	}
+
+	template <typename StreamT>
+	ros::Time AsyncManager<StreamT>::captureIngestStamp()
+	{
+#if defined(__linux__)
+		// On sockets the SIOCGSTAMPNS ioctl yields the kernel receive timestamp of the last packet handed
+		// to userspace, i.e. the wire-arrival time before any queueing in this process. On transports
+		// without packet timestamps (notably serial ports) the ioctl simply fails and the current time -
+		// taken right here in the read handler, well before parsing and decoding - serves as best effort.
+		struct timespec ts;
+		if (ioctl(stream_->native_handle(), SIOCGSTAMPNS, &ts) == 0 && ts.tv_sec != 0)
+		{
+			return ros::Time(static_cast<uint32_t>(ts.tv_sec), static_cast<uint32_t>(ts.tv_nsec));
+		}
+#endif
+		return ros::Time::now();
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::recordIngestStamp(const ros::Time& stamp)
+	{
+		std::size_t head = stamp_head_.load(std::memory_order_relaxed);
+		if (head - stamp_tail_.load(std::memory_order_acquire) == STAMP_JOURNAL_SIZE_)
+		// The journal only ever fills up while the parser lags dozens of bursts behind; the skipped
+		// burst's frames then reuse the newest stamp popped before, which in that regime is off by far
+		// less than the queueing delay itself.
+		{
+			return;
+		}
+		stamp_journal_[head & (STAMP_JOURNAL_SIZE_ - 1)].ring_offset = ring_buffer_.totalWritten();
+		stamp_journal_[head & (STAMP_JOURNAL_SIZE_ - 1)].stamp = stamp;
+		stamp_head_.store(head + 1, std::memory_order_release);
+	}
+
+	template <typename StreamT>
+	ros::Time AsyncManager<StreamT>::popIngestStamp(std::size_t parsed_end)
+	{
+		std::size_t tail = stamp_tail_.load(std::memory_order_relaxed);
+		std::size_t head = stamp_head_.load(std::memory_order_acquire);
+		while (tail != head && stamp_journal_[tail & (STAMP_JOURNAL_SIZE_ - 1)].ring_offset <= parsed_end)
+		{
+			last_ingest_stamp_ = stamp_journal_[tail & (STAMP_JOURNAL_SIZE_ - 1)].stamp;
+			++tail;
+		}
+		stamp_tail_.store(tail, std::memory_order_release);
+		return last_ingest_stamp_;
+	}
+
 	template <typename StreamT>
 	void AsyncManager<StreamT>::asyncReadSomeHandler(const boost::system::error_code& error,
 								std::size_t bytes_transferred) 
 	{
-		if (error) 
+		if (error)
+		{
+			if (stopping_) return; // The (expected) operation_aborted error of a stream being torn down..
+			ROS_ERROR("Rx ASIO input buffer read error: %s, %li", error.message().c_str(), bytes_transferred);
+			// A read error on an open stream means the link is gone (e.g. a dropped cellular TCP
+			// connection): instead of re-posting read()s on the dead stream over and over again, the
+			// connection-lost callback (if any) is invoked exactly once and hands over to the reconnect
+			// engine of the Comm_IO class, which will tear down and replace this very instance.
+			stopping_ = true;
+			if (connection_lost_callback_) connection_lost_callback_();
+			return;
+		}
+		else if (bytes_transferred > 0)
 		{
-			ROS_ERROR("Rx ASIO input buffer read error: %s, %li", error.message().c_str(), bytes_transferred); 
-		} 
-		else if (bytes_transferred > 0) 
-		{ 
+			if (raw_capture_)
+			{
+				// The capture stage comes before the hand-over: in the zero-copy path the bytes sit in the
+				// ring's write region until commitWrite() below publishes them to the parser. append() only
+				// memcpys into an in-memory buffer, the batched disk writes happen on the capture's own thread.
+				raw_capture_->append(reading_into_ring_ ? ring_buffer_.writePtr() : in_.data(),
+					bytes_transferred);
+			}
 			if (read_callback_) //Will be false in InitializeSerial (first call) since read_callback_ not added yet..
 			{
-				boost::mutex::scoped_lock lock(parse_mutex_);
-				parsing_condition_.wait(lock, [this](){return allow_writing_;});
-				circular_buffer_.write(in_.data(), bytes_transferred);
-				allow_writing_ = false;
-				try_parsing_ = true;
-				lock.unlock();
+				// Lock-free handover: the I/O thread publishes the bytes and pokes the (possibly parked)
+				// parser thread, but it never waits for the parser to drain the ring buffer.
+				// Note that in_ is deliberately left alone: the next async_read_some() simply overwrites it,
+				// which spares us one vector destruction plus construction per read.
+				if (reading_into_ring_)
+				{
+					// The bytes already sit in the ring's write region, publishing them is index arithmetic only.
+					ring_buffer_.commitWrite(bytes_transferred);
+				}
+				else
+				{
+					ring_buffer_.write(in_.data(), bytes_transferred);
+				}
+				// One clock read plus one relaxed atomic each, cf. the PipelineStats class description
+				PipelineStats::markIngest();
+				PipelineStats::recordRingOccupancy(ring_buffer_.size());
+				recordIngestStamp(captureIngestStamp());
 				parsing_condition_.notify_one();
-				std::vector<uint8_t> empty;
-				in_ = empty;
-				in_.resize(buffer_size_);
 			}
 		}
-	 
+
 		if (!stopping_)
-			io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
+		{
+			// Adaptive batching, cf. the read_batching_us_ member: a small read means the stream is merely
+			// trickling, hence the next read is deferred until the latency budget has elapsed, letting
+			// bytes accumulate in the kernel buffer s.t. they are ingested in one read instead of a
+			// syscall storm of tiny ones. A large read means there is backlog: read on immediately.
+			if (read_batching_us_ > 0 && bytes_transferred < buffer_size_ / 2)
+			{
+				batch_timer_.expires_from_now(boost::posix_time::microseconds(read_batching_us_));
+				batch_timer_.async_wait(boost::bind(&AsyncManager<StreamT>::batchTimerHandler, this,
+					boost::asio::placeholders::error));
+			}
+			else
+			{
+				io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
+			}
+		}
+	}
+
+	template <typename StreamT>
+	void AsyncManager<StreamT>::batchTimerHandler(const boost::system::error_code& error)
+	{
+		if (error || stopping_) return; // The (expected) operation_aborted error of a stream being torn down..
+		read();
 	}
 	 
 	template <typename StreamT>
@@ -402,7 +854,7 @@ namespace io_comm_rx
 		// It will be called a second time in TCP/IP mode since (just example) "IP10<" is transmitted.
 		{
 			ROS_INFO("No incoming messages, driver stopped, ros::spin() will spin forever unless you hit Ctrl+C.");
-			async_background_thread_->interrupt(); 
+			if (async_background_thread_) async_background_thread_->interrupt();
 		}
 	}
 }
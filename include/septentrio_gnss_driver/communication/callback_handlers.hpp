@@ -96,8 +96,10 @@
 #include <boost/thread/mutex.hpp>
 
 // ROSaic and C++ includes
+#include <septentrio_gnss_driver/communication/epoch_collator.hpp>
 #include <septentrio_gnss_driver/communication/rx_message.hpp>
 #include <algorithm>
+#include <deque>
 
 /**
  * @file callback_handlers.hpp
@@ -105,31 +107,19 @@
  * @brief Handles callbacks when reading NMEA/SBF messages
  */
 
-extern bool g_channelstatus_has_arrived_gpsfix;
-extern bool g_measepoch_has_arrived_gpsfix;
-extern bool g_dop_has_arrived_gpsfix;
-extern bool g_pvtgeodetic_has_arrived_gpsfix;
-extern bool g_pvtgeodetic_has_arrived_navsatfix;
-extern bool g_pvtgeodetic_has_arrived_pose;
-extern bool g_poscovgeodetic_has_arrived_gpsfix;
-extern bool g_poscovgeodetic_has_arrived_navsatfix;
-extern bool g_poscovgeodetic_has_arrived_pose;
-extern bool g_velcovgeodetic_has_arrived_gpsfix;
-extern bool g_atteuler_has_arrived_gpsfix;
-extern bool g_atteuler_has_arrived_pose;
-extern bool g_attcoveuler_has_arrived_gpsfix;
-extern bool g_attcoveuler_has_arrived_pose;
-extern bool g_receiverstatus_has_arrived_diagnostics;
-extern bool g_qualityind_has_arrived_diagnostics;
-
 extern bool g_publish_navsatfix;
 extern bool g_publish_gpsfix;
 extern bool g_publish_gpst;
 extern bool g_publish_pose;
 extern bool g_publish_diagnostics;
+extern bool g_publish_measepoch;
+extern bool g_publish_channelstatus;
 extern bool g_response_received;
 extern boost::mutex g_response_mutex;
 extern boost::condition_variable g_response_condition;
+extern uint32_t g_response_count;
+extern std::deque<std::string> g_outstanding_commands;
+extern std::string g_response_error;
 extern bool g_cd_received;
 extern boost::mutex g_cd_mutex;
 extern boost::condition_variable g_cd_condition;
@@ -145,7 +135,7 @@ namespace io_comm_rx
 	class AbstractCallbackHandler 
 	{
 		public:
-			virtual void handle(RxMessage& rx_message, std::string message_key) = 0;
+			virtual void handle(RxMessage& rx_message, RxIDType message_key) = 0;
 	 
 			bool Wait(const boost::posix_time::time_duration& timeout) 
 			{
@@ -169,7 +159,7 @@ namespace io_comm_rx
 			
 			virtual const T& Get() { return message_; }
 			
-			void handle(RxMessage& rx_message, std::string message_key) 
+			void handle(RxMessage& rx_message, RxIDType message_key)
 			{
 				boost::mutex::scoped_lock lock(mutex_);
 				try 
@@ -197,9 +187,73 @@ namespace io_comm_rx
 			}
 	   
 		private:
-			T message_; 
+			T message_;
 	};
-	 
+
+	/**
+	 * @class PublishOnlyCallbackHandler
+	 * @brief Derived class that only triggers decoding & publishing, without retaining a copy of the message
+	 *
+	 * The plain CallbackHandler above locks its mutex and has the read() method copy the freshly decoded
+	 * message into its stored message_ on every single block, yet that copy is only ever consumed by the
+	 * blocking Wait()/Get() path. Publishing itself happens inside read() already. For keys whose stored
+	 * copy nobody reads - the production case, and costly for large messages such as gps_common::GPSFix
+	 * and sensor_msgs::NavSatFix - this handler skips the mutex, the stored copy and the trailing memcpy.
+	 */
+	template <typename T>
+	class PublishOnlyCallbackHandler : public AbstractCallbackHandler
+	{
+		public:
+
+			void handle(RxMessage& rx_message, RxIDType message_key)
+			{
+				try
+				{
+					if (!rx_message.read<T>(scratch_, message_key, false, true))
+					{
+						std::ostringstream ss;
+						ss << "Read unsuccessful: Rx decoder error for message with ID (empty field if non-determinable)" <<
+							rx_message.messageID() << ". Reason unknown.";
+						throw std::runtime_error(ss.str());
+						ROS_INFO("%s", ss.str().c_str());
+						return;
+					}
+				} catch (std::runtime_error& e)
+				{
+					std::ostringstream ss;
+					ss << "Read unsuccessful: Rx decoder error for message with ID " <<
+						rx_message.messageID() << ".\n" << e.what();
+					throw std::runtime_error(ss.str());
+					ROS_INFO("%s", ss.str().c_str());
+					return;
+				}
+			}
+
+		private:
+			//! Never written to since read() is called in publish-only mode; merely satisfies the reference
+			//! parameter of the read() method
+			T scratch_;
+	};
+
+	/**
+	 * @class RawBlockCallbackHandler
+	 * @brief Derived class republishing the block's raw bytes, without any decoding
+	 *
+	 * For consumers that re-parse SBF themselves, running the full read() decode plus ROS message
+	 * construction only to republish information they re-derive is wasted CPU: this handler merely copies
+	 * the - already framed - block verbatim into a septentrio_gnss_driver::RawBlock message, s.t. decode
+	 * cost is only ever paid for block IDs somebody wants decoded, cf. the publish/raw_sbf_ids parameter.
+	 */
+	class RawBlockCallbackHandler : public AbstractCallbackHandler
+	{
+		public:
+
+			void handle(RxMessage& rx_message, RxIDType message_key)
+			{
+				rx_message.publishRawBlock(message_key);
+			}
+	};
+
 	/**
 	 * @class CallbackHandlers
 	 * @brief Represents ensemble of (to be constructed) ROS messages, to be handled at once by this class
@@ -209,11 +263,19 @@ namespace io_comm_rx
 		
 		public:
 			
-			//! Key is std::string and represents the ROS message key, value is boost::shared_ptr<CallbackHandler> 
-			typedef std::multimap<std::string, boost::shared_ptr<AbstractCallbackHandler>> CallbackMap;
+			//! Key is the numeric message ID (RxIDType), value is boost::shared_ptr<CallbackHandler>
+			typedef std::multimap<RxIDType, boost::shared_ptr<AbstractCallbackHandler>> CallbackMap;
 			
 			CallbackHandlers() = default;
-			
+
+			/**
+			 * @brief Constructor tying the handlers to one particular receiver stream
+			 * @param stream_id The receiver stream the handlers serve, 0 being the primary receiver
+			 * @param topic_prefix The stream's topic prefix, empty for the primary receiver
+			 */
+			CallbackHandlers(std::size_t stream_id, const std::string& topic_prefix) :
+				stream_id_(stream_id), topic_prefix_(topic_prefix) {}
+
 			/**
 			 * @brief Adds a pair to the multimap "callbackmap_", with the message_key being the key
 			 * 
@@ -221,22 +283,54 @@ namespace io_comm_rx
 			 * T would be a (custom or not) ROS message, e.g. septentrio_gnss_driver::PVTGeodetic, or nmea_msgs::GPGGA.
 			 * Note that "typename" could be omitted in the argument.
 			 * @param message_key The pair's key
-			 * @param callback The key's counterpart
+			 * @param publish_only Whether a PublishOnlyCallbackHandler (no mutex, no stored copy of the
+			 * message, no blocking Wait()/Get() support) shall be constructed instead of a CallbackHandler
 			 * @return The modified multimap "callbackmap_"
 			 */
-			template <typename T> 
-			CallbackMap insert(std::string message_key)
+			template <typename T>
+			CallbackMap insert(RxIDType message_key, bool publish_only = false)
 			{
 				boost::mutex::scoped_lock lock(callback_mutex_);
 				// Adding typename might be cleaner, but is optional again
-				CallbackHandler<T>* handler = new CallbackHandler<T>(); 
+				AbstractCallbackHandler* handler;
+				if (publish_only)
+				{
+					handler = new PublishOnlyCallbackHandler<T>();
+				}
+				else
+				{
+					handler = new CallbackHandler<T>();
+				}
 				callbackmap_.insert(std::make_pair(message_key, boost::shared_ptr<AbstractCallbackHandler>(handler)));
+				rebuildDispatchTable(callbackmap_);
 				CallbackMap::key_type key = message_key;
-				ROS_DEBUG("Key %s successfully inserted into multimap: %s", message_key.c_str(),
+				ROS_DEBUG("Key %u successfully inserted into multimap: %s", static_cast<unsigned int>(message_key),
 					((unsigned int) callbackmap_.count(key)) ? "true" : "false");
 				return callbackmap_;
 			}
-			
+
+			/**
+			 * @brief Registers a raw passthrough handler for the given block ID
+			 *
+			 * Unlike insert(), no ROS message type is involved: the registered RawBlockCallbackHandler
+			 * republishes the block's bytes verbatim, cf. the publish/raw_sbf_ids parameter. Raw handlers
+			 * live in a table of their own rather than in callbackmap_, since handle() dispatches them
+			 * unconditionally, before (and irrespective of) its decode-flag gating: listing e.g. MeasEpoch
+			 * precisely to skip its decode must still reach the /rawblock topic.
+			 * @param message_key The SBF block ID to be passed through raw
+			 */
+			void insertRaw(RxIDType message_key)
+			{
+				boost::mutex::scoped_lock lock(callback_mutex_);
+				if (raw_dispatch_table_.empty())
+				{
+					raw_dispatch_table_.resize(RX_ID_TABLE_SIZE);
+				}
+				raw_dispatch_table_[message_key].reset(new RawBlockCallbackHandler());
+				ROS_DEBUG("Key %u successfully registered as raw passthrough",
+					static_cast<unsigned int>(message_key));
+			}
+
 			/**
 			 * @brief Ćalled every time rx_message is found to contain some potentially useful message
 			 * @param rx_message
@@ -244,71 +338,187 @@ namespace io_comm_rx
 			void handle(RxMessage& rx_message);
 			
 			/**
-			 * @brief Searches for Rx messages that could potentially be decoded/parsed/published  
+			 * @brief Searches for Rx messages that could potentially be decoded/parsed/published
 			 * @param[in] data Buffer passed on from AsyncManager class
 			 * @param[in] size Size of the buffer
+			 * @param[in] ingest_stamp Wire-arrival time of the buffer's newest bytes as captured by the
+			 * AsyncManager class; stamps the published messages in case use_gnss_time is false. The default
+			 * (a zero time) makes the decode path fall back to sampling the clock itself, cf. the
+			 * messageStamp() method of the RxMessage class - intended for callers without a live stream,
+			 * i.e. the SBF file playback and the benchmark
+			 */
+			void readCallback(const uint8_t* data, std::size_t& size,
+				const ros::Time& ingest_stamp = ros::Time());
+
+			/**
+			 * @brief Decodes and publishes one complete frame, called by the workers of the
+			 * DecodeWorkerPool class
+			 *
+			 * The frame was already framed and - if SBF - CRC-validated by readCallback() on the parser
+			 * thread and copied out of the ring buffer; cf. the DecodeWorkerPool class for the ordering
+			 * guarantees that make calling this method from several threads safe.
+			 * @param[in] frame Start of the complete frame
+			 * @param[in] size Size of the complete frame in bytes
+			 * @param[in] ingest_stamp Wire-arrival time of the frame, cf. readCallback()
 			 */
-			void readCallback(const uint8_t* data, std::size_t& size);
+			void handleFrame(const uint8_t* frame, std::size_t size, const ros::Time& ingest_stamp);
+
+			//! Whether the given SBF block contributes to one of the composite ROS messages (GPSFix,
+			//! NavSatFix, PoseWithCovarianceStamped, DiagnosticArray) and hence touches state shared
+			//! across message types; public since the DecodeWorkerPool class pins all such blocks to
+			//! one and the same worker, cf. its enqueue() method
+			static bool isCompositeConstituent(RxIDType message_key);
+
+			//! Signature of the optional decode profiler, cf. setDecodeProfiler(); called once per handled
+			//! message with the numeric message ID and the nanoseconds its handling took
+			typedef void (*DecodeProfiler)(RxIDType message_key, int64_t nanoseconds);
+
+			/**
+			 * @brief Registers a function to be called with the decode cost of every handled message
+			 *
+			 * Solely meant for the benchmark executable: readCallback() times each handle() invocation and
+			 * reports it under the message's numeric ID. The cost of composite ROS messages (NavSatFix,
+			 * GPSFix etc.) is attributed to the SBF block whose arrival triggered their construction. With
+			 * no profiler registered (the default), the hot path merely pays one well-predicted branch.
+			 * @param[in] profiler The function to be called, or NULL to switch profiling back off
+			 */
+			static void setDecodeProfiler(DecodeProfiler profiler);
 			
 			//! Callback handlers multimap for Rx messages; it needs to be public since we copy-assign 
 			//! (did not work otherwise) new callbackmap_, 
 			//! after inserting a pair to the multimap within the DefineMessages() method of the ROSaicNode 
 			//! class, onto its old version.
 			CallbackMap callbackmap_;
-		
+
 		private:
+
+			//! The receiver stream these handlers serve, 0 being the primary receiver; handed over to each
+			//! RxMessage s.t. the publisher registry is indexed per stream
+			std::size_t stream_id_ = 0;
+
+			//! The stream's topic prefix, empty for the primary receiver
+			std::string topic_prefix_;
 			
-			//! The "static" keyword resolves construct-by-copying issues related to this mutex by making 
-			//! it available throughout the code unit. The mutex constructor list contains "mutex 
+			//! The "static" keyword resolves construct-by-copying issues related to this mutex by making
+			//! it available throughout the code unit. The mutex constructor list contains "mutex
 			//! (const mutex&) = delete", hence construct-by-copying a mutex is explicitly prohibited.
 			//! The get_handlers() method of the Comm_IO class hence forces us to make this mutex static.
-			static boost::mutex callback_mutex_; 
+			static boost::mutex callback_mutex_;
+
+			//! Guards the state the composite ROS messages are assembled from across message types - the
+			//! last_.. copies of the RxMessage class, the epoch collators and the do_.. triggers - once the
+			//! decode stage runs on the workers of the DecodeWorkerPool class; static for the same
+			//! construct-by-copying reason as callback_mutex_ above
+			static boost::mutex decode_state_mutex_;
+
+			//! Shorthand for one slot of the flat dispatch table below
+			typedef std::vector<boost::shared_ptr<AbstractCallbackHandler>> HandlerList;
+
+			//! Flat dispatch table indexed by the numeric message ID: handler lookup on the hot path thereby
+			//! becomes a single indexed load instead of a red-black-tree traversal through callbackmap_. It is
+			//! rebuilt from the multimap on every insert() - which only happens at startup within the
+			//! defineMessages() method of the ROSaicNode class - and static for the same construct-by-copying
+			//! reason as callback_mutex_ above.
+			static std::vector<HandlerList> dispatch_table_;
+
+			//! Flat table of the raw passthrough handlers, indexed by the SBF block ID, one handler per ID
+			//! at most; empty until the first insertRaw() call and separate from dispatch_table_ since
+			//! handle() dispatches raw handlers unconditionally, ahead of its decode-flag gating
+			static std::vector<boost::shared_ptr<AbstractCallbackHandler>> raw_dispatch_table_;
+
+			/**
+			 * @brief Rebuilds dispatch_table_ from the given multimap
+			 * @param callbackmap The multimap acting as the source of truth for registered handlers
+			 */
+			static void rebuildDispatchTable(const CallbackMap& callbackmap);
+
+			/**
+			 * @brief Invokes the raw passthrough handler registered for the given block ID, if any
+			 *
+			 * Same locking discipline as dispatch(): the callback_mutex_ merely pins the table during
+			 * lookup, the handler itself runs unlocked.
+			 * @param rx_message The message to be passed through
+			 * @param[in] key The numeric ID of the framed message
+			 */
+			static void dispatchRaw(RxMessage& rx_message, CallbackMap::key_type key);
+
+			//! The registered decode profiler, NULL (i.e. no timing overhead) outside the benchmark,
+			//! cf. setDecodeProfiler()
+			static DecodeProfiler decode_profiler_;
 			
-			//! Determines which of the SBF blocks necessary for the gps_common::GPSFix ROS message arrives last 
+			//! Determines which of the SBF blocks necessary for the gps_common::GPSFix ROS message arrives last
 			//! and thus launches its construction
-			static std::string do_gpsfix_;
-			
-			//! Determines which of the SBF blocks necessary for the sensor_msgs::NavSatFix ROS message arrives 
+			static RxIDType do_gpsfix_;
+
+			//! Determines which of the SBF blocks necessary for the sensor_msgs::NavSatFix ROS message arrives
 			//! last and thus launches its construction
-			static std::string do_navsatfix_;
-			
-			//! Determines which of the SBF blocks necessary for the geometry_msgs/PoseWithCovarianceStamped ROS 
+			static RxIDType do_navsatfix_;
+
+			//! Determines which of the SBF blocks necessary for the geometry_msgs/PoseWithCovarianceStamped ROS
 			//! message arrives last and thus launches its construction
-			static std::string do_pose_;
-			
-			//! Determines which of the SBF blocks necessary for the diagnostic_msgs/DiagnosticArray ROS message 
+			static RxIDType do_pose_;
+
+			//! Determines which of the SBF blocks necessary for the diagnostic_msgs/DiagnosticArray ROS message
 			//! arrives last and thus launches its construction
-			static std::string do_diagnostics_;
-			
-			//! Shorthand for the map responsible for matching ROS message identifiers relevant for GPSFix to a uint32_t
-			typedef std::map<std::string, uint32_t> GPSFixMap;
-			
-			//! All instances of the CallbackHandlers class shall have access to the map without reinitializing it, 
-			//! hence static
-			static GPSFixMap gpsfix_map;
+			static RxIDType do_diagnostics_;
 
-			//! Shorthand for the map responsible for matching ROS message identifiers relevant for NavSatFix to a uint32_t
-			typedef std::map<std::string, uint32_t> NavSatFixMap;
-			
-			//! All instances of the CallbackHandlers class shall have access to the map without reinitializing it, 
-			//! hence static
-			static NavSatFixMap navsatfix_map;
+			/**
+			 * @brief Invokes all handlers registered under the given key on the given message
+			 *
+			 * The callback_mutex_ is only held while looking the handlers up: the dispatch table is only
+			 * ever mutated by insert() while the handlers are being registered at startup, and holding the
+			 * lock across the callbacks themselves would serialize the workers of the DecodeWorkerPool
+			 * class on it.
+			 * @param rx_message The message to be handled
+			 * @param[in] key The numeric ID the handlers were registered under
+			 */
+			static void dispatch(RxMessage& rx_message, CallbackMap::key_type key);
 
-			//! Shorthand for the map responsible for matching ROS message identifiers relevant for
-			//! PoseWithCovarianceStamped to a uint32_t
-			typedef std::map<std::string, uint32_t> PoseWithCovarianceStampedMap;
-			
-			//! All instances of the CallbackHandlers class shall have access to the map without reinitializing it, 
-			//! hence static
-			static PoseWithCovarianceStampedMap pose_map;
-			
-			//! Shorthand for the map responsible for matching ROS message identifiers relevant for DiagnosticArray
-			//! to a uint32_t
-			typedef std::map<std::string, uint32_t> DiagnosticArrayMap;
-			
-			//! All instances of the CallbackHandlers class shall have access to the map without reinitializing it, 
-			//! hence static
-			static DiagnosticArrayMap diagnosticarray_map;
+			/**
+			 * @brief Feeds the given SBF block to the epoch collators of all composite ROS messages it is
+			 * a constituent of, setting the corresponding do_.. trigger whenever it completes an epoch
+			 * @param rx_message The just framed SBF block
+			 */
+			static void collate(RxMessage& rx_message);
+
+			/**
+			 * @brief Collates (if an SBF constituent block, under decode_state_mutex_) and handles the
+			 * message rx_message currently points to
+			 *
+			 * Single entry into the decode + publish stage for both the single-threaded pipeline and the
+			 * workers of the DecodeWorkerPool class.
+			 * @param rx_message The just framed message
+			 */
+			void collateAndHandle(RxMessage& rx_message);
+
+			//! Returns the bit the given SBF block occupies in the GPSFix collator's arrival bitmask, 0 for
+			//! blocks that are no GPSFix constituents
+			static uint32_t gpsfixBit(RxIDType message_key);
+
+			//! Returns the bit the given SBF block occupies in the NavSatFix collator's arrival bitmask, 0 for
+			//! blocks that are no NavSatFix constituents
+			static uint32_t navsatfixBit(RxIDType message_key);
+
+			//! Returns the bit the given SBF block occupies in the PoseWithCovarianceStamped collator's arrival
+			//! bitmask, 0 for blocks that are no PoseWithCovarianceStamped constituents
+			static uint32_t poseBit(RxIDType message_key);
+
+			//! Returns the bit the given SBF block occupies in the DiagnosticArray collator's arrival bitmask,
+			//! 0 for blocks that are no DiagnosticArray constituents
+			static uint32_t diagnosticarrayBit(RxIDType message_key);
+
+			//! Collates the GPSFix constituent blocks by their TOW/WNc epoch; like the dispatch table, the
+			//! collators aggregate over all receiver streams and are hence static
+			static EpochCollator gpsfix_collator_;
+
+			//! Collates the NavSatFix constituent blocks by their TOW/WNc epoch
+			static EpochCollator navsatfix_collator_;
+
+			//! Collates the PoseWithCovarianceStamped constituent blocks by their TOW/WNc epoch
+			static EpochCollator pose_collator_;
+
+			//! Collates the DiagnosticArray constituent blocks by their TOW/WNc epoch
+			static EpochCollator diagnosticarray_collator_;
 	};
 	
 }
@@ -98,21 +98,86 @@ namespace io_comm_rx
 	/**
 	 * @class Comm_IO
 	 * @brief Handles communication with and configuration of the mosaic (and beyond) receiver(s)
+	 *
+	 * One Comm_IO instance serves one receiver stream. A node ingesting several receivers (cf. the
+	 * multi_receiver ROS parameters) constructs one instance per stream, each with its own stream ID and
+	 * topic prefix, and multiplexes all of them over the shared io_service thread pool started via
+	 * startIOThreadPool() instead of paying one dedicated I/O thread per stream.
 	 */
-	class Comm_IO 
+	class Comm_IO
 	{
 		public:
-			
+
 			/**
 			* @brief Default constructor of the class Comm_IO
 			*/
-			Comm_IO(); 
-			
+			Comm_IO();
+
+			/**
+			* @brief Constructor tying the instance to one particular receiver stream
+			* @param[in] stream_id The receiver stream this instance serves, 0 being the primary receiver
+			* @param[in] topic_prefix The stream's topic prefix, empty for the primary receiver
+			*/
+			Comm_IO(std::size_t stream_id, const std::string& topic_prefix);
+
 			/**
 			* @brief Default destructor of the class Comm_IO
 			*/
 			virtual ~Comm_IO() = default;
-			
+
+			/**
+			 * @brief Starts the shared io_service thread pool over which all receiver streams are multiplexed
+			 *
+			 * Must be called before the first initializeSerial()/initializeTCP() call in order to take effect;
+			 * without it each stream spawns its own dedicated I/O thread, exactly as before.
+			 * @param[in] thread_pool_size Number of threads invoking the shared io_service's run() method
+			 */
+			static void startIOThreadPool(std::size_t thread_pool_size);
+
+			/**
+			 * @brief Configures the reconnect engine's exponential backoff, shared by all Comm_IO instances
+			 *
+			 * Must be called before the first connection is initialized in order to take effect.
+			 * @param[in] initial_delay_s Delay in seconds before the first reconnection attempt, doubled after
+			 * every failed attempt
+			 * @param[in] max_delay_s Ceiling in seconds the doubling delay saturates at
+			 */
+			static void configureReconnect(float initial_delay_s, float max_delay_s);
+
+			/**
+			 * @brief Configures the serial ingest latency budget, shared by all Comm_IO instances
+			 *
+			 * Must be called before the first initializeSerial() call in order to take effect. With a
+			 * budget of 0 the port is put into low-latency mode and every read is re-posted immediately,
+			 * i.e. each byte reaches the parser as soon as the port offers it; with a positive budget the
+			 * reader defers its next read by up to that many milliseconds after a small one, trading the
+			 * deferral for fewer, larger reads, cf. the AsyncManager class.
+			 * @param[in] max_latency_ms Latency budget in milliseconds the serial reader may spend batching
+			 * trickling bytes into larger reads
+			 */
+			static void configureSerialBatching(float max_latency_ms);
+
+			/**
+			 * @brief Configures the capacity of the receive ring buffer, shared by all Comm_IO instances
+			 *
+			 * Must be called before the first connection is initialized in order to take effect. The ring
+			 * decouples the I/O thread from the parser thread, cf. the SPSCRingBuffer class; sizing it
+			 * trades memory against how long the parser may lag behind the stream before the ring's
+			 * drop-oldest overflow policy starts evicting unread epochs.
+			 * @param[in] capacity_bytes Ring capacity in bytes, rounded up to the next power of two;
+			 * values below twice the read buffer size are raised to that minimum
+			 */
+			static void configureRingBuffer(std::size_t capacity_bytes);
+
+			/**
+			 * @brief Sets the callback to be called once the reconnect engine has re-established a lost connection
+			 *
+			 * The transport is alive again by the time the callback runs, but the Rx's output streams might point
+			 * to the stale connection descriptor, hence the primary receiver re-runs its configuration here.
+			 * @param[in] callback The callback to be called, from the reconnect engine's own thread
+			 */
+			void setReconnectedCallback(const boost::function<void()>& callback);
+
 			/**
 			 * @brief Initializes the serial port
 			 * @param[in] port The device's port address
@@ -130,7 +195,33 @@ namespace io_comm_rx
 			 * @return True if connection could be established, false otherwise
 			 */
 			bool initializeTCP(std::string host, std::string port);
-			
+
+			/**
+			 * @brief Initializes the UDP I/O, unicast and multicast alike
+			 *
+			 * The socket is bound to the given port on all local interfaces. A multicast host is joined
+			 * as a group, s.t. one receiver stream can feed any number of listening driver instances; a
+			 * non-empty unicast host is connected to, s.t. the kernel filters out datagrams of unrelated
+			 * senders. Either way the socket is drained with batched multi-datagram receives, cf. the
+			 * AsyncManager class: one syscall ingests a whole burst of SBF packets.
+			 * @param[in] host The sender's address or the multicast group to join, may be empty to accept any sender
+			 * @param[in] port The local UDP port the receiver streams to
+			 * @return True if the socket could be set up, false otherwise
+			 */
+			bool initializeUDP(std::string host, std::string port);
+
+			/**
+			 * @brief Replays a logged SBF file through the decode pipeline at full CPU speed
+			 *
+			 * The file is memory-mapped and fed through the very same readCallback() the live streams use,
+			 * in large chunks, s.t. a multi-hour log reprocesses in seconds. For the ROS message stamps to
+			 * reflect the time of recording rather than the time of replay, the use_gnss_time parameter
+			 * should be set to true: the stamps are then constructed from the TOW embedded in each block.
+			 * @param[in] file_path Path of the SBF file to be replayed
+			 * @return True if the file could be mapped and replayed, false otherwise
+			 */
+			bool initializeSBFFileReader(const std::string& file_path);
+
 			
 			/**
 			 * @brief Set the I/O manager
@@ -152,7 +243,24 @@ namespace io_comm_rx
 			CallbackHandlers handlers_;
 	  
 		private:
-		
+
+			/**
+			 * @brief Called (at most once per established connection) once the AsyncManager declares the link dead
+			 *
+			 * Invoked from the dying stream's I/O thread, hence it merely spawns the reconnectLoop() thread:
+			 * tearing down the AsyncManager from within one of its own threads would deadlock its destructor.
+			 */
+			void handleConnectionLost();
+
+			/**
+			 * @brief Tears down the dead stream and retries the stored connection with exponential backoff
+			 *
+			 * Runs on its own (detached) thread until the connection is re-established (or ROS shuts down),
+			 * with the delay between attempts doubling from reconnect_initial_delay_s_ up to
+			 * reconnect_max_delay_s_, and finally invokes the reconnected callback, if any.
+			 */
+			void reconnectLoop();
+
 			//! Saves the port description
 			std::string serial_port_;
 			//! Processes I/O stream data
@@ -168,6 +276,40 @@ namespace io_comm_rx
 			std::string host_;
 			//! Port over which TCP/IP connection is currently established
 			std::string port_;
+			//! Hardware flow control setting of the serial connection, saved for reconnection attempts
+			std::string flowcontrol_;
+			//! Whether the established connection is a serial one (as opposed to TCP or UDP), s.t. the
+			//! reconnect engine knows which of the initialization paths to retry
+			bool serial_mode_;
+			//! Whether the established connection is a UDP one, s.t. the reconnect engine retries
+			//! initializeUDP() rather than initializeTCP()
+			bool udp_mode_;
+			//! Whether a reconnectLoop() thread is currently running, s.t. repeated read errors of one and
+			//! the same dead stream spawn at most one
+			bool reconnecting_;
+			//! Mutex guarding reconnecting_
+			boost::mutex reconnect_mutex_;
+			//! Callback to be called once a lost connection has been re-established, cf. setReconnectedCallback()
+			boost::function<void()> reconnected_callback_;
+			//! Delay in seconds before the reconnect engine's first reconnection attempt, doubled after every
+			//! failed one
+			static float reconnect_initial_delay_s_;
+			//! Ceiling in seconds the reconnect engine's doubling delay saturates at
+			static float reconnect_max_delay_s_;
+			//! Latency budget in milliseconds the serial reader may spend batching trickling bytes into
+			//! larger reads, cf. configureSerialBatching()
+			static float serial_batching_latency_ms_;
+			//! Capacity in bytes of the receive ring buffer each AsyncManager is constructed with,
+			//! cf. configureRingBuffer()
+			static std::size_t ring_capacity_;
+			//! The shared io_service all receiver streams are multiplexed over, empty unless
+			//! startIOThreadPool() was called
+			static boost::shared_ptr<boost::asio::io_service> shared_io_service_;
+			//! Keeps the shared io_service's run() method from returning while no asynchronous operation is
+			//! outstanding
+			static boost::shared_ptr<boost::asio::io_service::work> shared_io_work_;
+			//! The threads invoking the shared io_service's run() method
+			static std::vector<boost::shared_ptr<boost::thread>> shared_io_threads_;
 			//! Sleep time in microseconds (there is no Unix command for milliseconds) 
 			//! after setting the baudrate to certain value (important between increments)
 			const static unsigned int SET_BAUDRATE_SLEEP_ = 500000;
@@ -0,0 +1,186 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef DECODE_WORKER_POOL_HPP
+#define DECODE_WORKER_POOL_HPP
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+// Boost includes
+#include <boost/shared_ptr.hpp>
+// ROS includes
+#include <ros/time.h>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+/**
+ * @file decode_worker_pool.hpp
+ * @date 01/09/26
+ * @brief Pool of worker threads decoding and publishing complete frames behind the frame scanner
+ */
+
+//! Numeric ID under which Rx messages are keyed, cf. rx_message.hpp; redeclared here (it is a plain
+//! typedef) s.t. this header need not pull in the full rx_message.hpp
+typedef uint16_t RxIDType;
+
+namespace io_comm_rx
+{
+	class CallbackHandlers;
+
+	/**
+	 * @class DecodeWorkerPool
+	 * @brief Runs the decode + publish stage of the pipeline on a configurable number of worker threads
+	 *
+	 * The parser thread of the AsyncManager class keeps doing what only it can do with the ring buffer's
+	 * bytes in hand: hunting for sync pairs, validating the CRC (without which an SBF block's announced
+	 * length - and hence the jump to the next block - cannot be trusted, cf. the next() method of the
+	 * RxMessage class) and deciding where one frame ends and the next begins. Every complete frame is then
+	 * copied out of the ring and enqueued here, and the expensive remainder - decoding the block into a ROS
+	 * message and publishing it - happens on the workers.
+	 *
+	 * Frames are not stolen between workers: a frame is assigned to the worker whose index equals the
+	 * numeric message ID modulo the thread count, and each worker drains its queue strictly in FIFO order.
+	 * All frames of one message type thereby decode on one and the same worker in arrival order, which both
+	 * preserves the per-type publishing order and makes the per-type static state inside the read() method
+	 * of the RxMessage class (message pools, NMEA parsers) single-threaded by construction. State shared
+	 * across types - the last_.. copies the composite ROS messages are assembled from, the epoch collators
+	 * and the do_.. triggers - is one state machine spanning several block IDs, hence all blocks
+	 * contributing to a composite ROS message pin to one and the same worker (cf. enqueue()): only then do
+	 * they collate and decode in arrival order, without a fast worker's epoch T+1 block overwriting a
+	 * last_.. copy that a slower worker's epoch T composite message is yet to be assembled from.
+	 *
+	 * Each worker's queue is bounded: once a queue holds MAX_QUEUED_FRAMES frames, enqueue() blocks the
+	 * parser thread until the worker catches up, s.t. a slow subscriber ultimately backs up into the ring
+	 * buffer, whose occupancy the PipelineStats class already tracks.
+	 */
+	class DecodeWorkerPool
+	{
+		public:
+
+			/**
+			 * @brief Creates the process-wide pool, called once before any IO is initialized
+			 *
+			 * With a thread count of 0 (the default, and the fallback whenever this method is never
+			 * called), no pool is created and the pipeline runs single-threaded on the parser thread
+			 * as it always has.
+			 * @param[in] thread_count Number of decode worker threads to spawn
+			 */
+			static void configure(uint32_t thread_count);
+
+			/**
+			 * @brief The process-wide pool, NULL if decoding was left single-threaded
+			 */
+			static DecodeWorkerPool* instance();
+
+			/**
+			 * @brief Copies the given frame and hands it to the worker its message ID pins it to
+			 *
+			 * Blocks if that worker's queue is full, cf. above.
+			 * @param[in] handlers The CallbackHandlers instance (i.e. the receiver stream) the frame
+			 * belongs to, whose handleFrame() method the worker will call
+			 * @param[in] message_key Numeric ID of the framed message, used solely to pick the worker
+			 * @param[in] frame Start of the complete frame within the ring buffer
+			 * @param[in] size Size of the complete frame in bytes
+			 * @param[in] ingest_stamp Wire-arrival time of the frame, handed through to handleFrame()
+			 */
+			void enqueue(CallbackHandlers* handlers, RxIDType message_key, const uint8_t* frame,
+				std::size_t size, const ros::Time& ingest_stamp);
+
+			/**
+			 * @brief Drains all queues and joins the workers
+			 */
+			~DecodeWorkerPool();
+
+		private:
+
+			/**
+			 * @brief Spawns the workers; private since construction goes through configure()
+			 * @param[in] thread_count Number of decode worker threads to spawn
+			 */
+			explicit DecodeWorkerPool(uint32_t thread_count);
+
+			//! One frame copied out of the ring buffer, waiting to be decoded and published
+			struct DecodeJob
+			{
+				//! The CallbackHandlers instance (receiver stream) the frame belongs to
+				CallbackHandlers* handlers;
+				//! The frame's bytes, from sync pair to trailing byte
+				std::vector<uint8_t> frame;
+				//! Wire-arrival time of the frame, cf. the ingest stamp journal of the AsyncManager class
+				ros::Time ingest_stamp;
+				//! The same arrival time on the steady clock, in nanoseconds: the worker seeds its
+				//! thread-local latency bookkeeping from it before decoding, s.t. the ingest-to-publish
+				//! histogram measures against the frame's true ingest and not against an unseeded 0,
+				//! cf. PipelineStats::seedChunkStart()
+				uint64_t ingest_ns;
+			};
+
+			//! One worker's inbox; a struct of its own since mutexes and condition variables prohibit
+			//! construct-by-copying, hence the workers hold them through shared_ptr
+			struct WorkerQueue
+			{
+				//! Guards jobs below
+				boost::mutex mutex;
+				//! Signalled by enqueue() when a job was pushed
+				boost::condition_variable pushed;
+				//! Signalled by the worker when a job was popped, unblocking a full-queue enqueue()
+				boost::condition_variable popped;
+				//! The jobs themselves, drained strictly in FIFO order
+				std::deque<DecodeJob> jobs;
+			};
+
+			/**
+			 * @brief Body of each worker thread: pops jobs off its queue and decodes them
+			 * @param[in] worker_index Index of the queue (and thread) this invocation serves
+			 */
+			void work(std::size_t worker_index);
+
+			//! Upper bound on the frames a single worker's queue may hold before enqueue() blocks
+			static const std::size_t MAX_QUEUED_FRAMES = 256;
+
+			//! The process-wide pool, cf. configure() and instance()
+			static DecodeWorkerPool* instance_;
+
+			//! One inbox per worker
+			std::vector<boost::shared_ptr<WorkerQueue>> queues_;
+
+			//! The worker threads themselves
+			std::vector<boost::shared_ptr<boost::thread>> workers_;
+
+			//! Set by the destructor; workers finish their queue's remaining jobs, then exit
+			bool stopping_;
+	};
+}
+
+#endif // for DECODE_WORKER_POOL_HPP
@@ -0,0 +1,113 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef EPOCH_COLLATOR_HPP
+#define EPOCH_COLLATOR_HPP
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file epoch_collator.hpp
+ * @date 01/09/26
+ * @brief Groups the constituent SBF blocks of a composite ROS message by their TOW/WNc epoch
+ */
+
+namespace io_comm_rx
+{
+	/**
+	 * @class EpochCollator
+	 * @brief Tracks, per pending epoch, which constituent SBF blocks of one composite ROS message have arrived
+	 *
+	 * One instance serves one composite ROS message (GPSFix, NavSatFix, PoseWithCovarianceStamped or
+	 * DiagnosticArray). Every arriving constituent block reports the epoch it belongs to - the TOW/WNc pair
+	 * of its time stamp field - via collate(), which keeps one arrival bitmask per pending epoch and
+	 * reports completion as soon as an epoch's mask covers all constituents. Blocks of different epochs can
+	 * thereby never be collated into one composite message: a constituent that was lost (e.g. to a CRC
+	 * failure) leaves its epoch incomplete forever, and such epochs are aged out - either by newer epochs
+	 * taking their slot once the (small, linearly scanned) epoch table is full, or wholesale once a newer
+	 * epoch completes. Blocks whose time stamp carries the Do-Not-Use value simply collate under that very
+	 * key, which reproduces the old whoever-arrives-completes behavior for them.
+	 */
+	class EpochCollator
+	{
+		public:
+
+			/**
+			 * @brief Constructor of the EpochCollator class
+			 * @param[in] complete_mask Bitwise OR of the bits of all constituent blocks; an epoch is complete
+			 * once its arrival bitmask equals this mask
+			 */
+			explicit EpochCollator(uint32_t complete_mask);
+
+			/**
+			 * @brief Records the arrival of one constituent block for the epoch identified by TOW/WNc
+			 * @param[in] constituent_bit The bit the arriving block occupies in the arrival bitmask
+			 * @param[in] tow Time of week of the block's time stamp field, in milliseconds
+			 * @param[in] wnc Week number counter of the block's time stamp field
+			 * @return True if this very arrival completed its epoch's set of constituents, false otherwise
+			 */
+			bool collate(uint32_t constituent_bit, uint32_t tow, uint16_t wnc);
+
+		private:
+
+			//! One not-yet-complete epoch together with the constituents that have arrived for it so far
+			struct PendingEpoch
+			{
+				//! WNc and TOW combined into one chronologically ordered key, cf. epochKey()
+				uint64_t key;
+				//! Bitwise OR of the bits of the constituent blocks that have arrived for this epoch
+				uint32_t arrived_mask;
+			};
+
+			//! Combines WNc and TOW into one key whose integer order is the chronological order of the epochs
+			static uint64_t epochKey(uint32_t tow, uint16_t wnc)
+			{
+				return (static_cast<uint64_t>(wnc) << 32) | static_cast<uint64_t>(tow);
+			}
+
+			//! Number of epochs that can be pending at once; small on purpose, s.t. the lookup is a short
+			//! linear scan over one cache line rather than a tree traversal, and s.t. incomplete epochs
+			//! cannot pile up
+			static const std::size_t MAX_PENDING_EPOCHS = 4;
+
+			//! The pending epochs, unordered; only the first size_ entries are valid
+			PendingEpoch pending_[MAX_PENDING_EPOCHS];
+
+			//! Number of currently pending epochs
+			std::size_t size_;
+
+			//! Bitwise OR of the bits of all constituent blocks, cf. the constructor
+			uint32_t complete_mask_;
+	};
+}
+
+#endif // for EPOCH_COLLATOR_HPP
@@ -0,0 +1,119 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef MESSAGE_POOL_HPP
+#define MESSAGE_POOL_HPP
+
+// C++ library includes
+#include <cstddef>
+#include <vector>
+// Boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+
+/**
+ * @file message_pool.hpp
+ * @brief Defines a class template MessagePool that recycles ROS messages (shared_ptr control block included)
+ * @date 01/09/26
+ */
+
+namespace io_comm_rx
+{
+	/**
+	 * @brief Pool of ROS messages of one type from which steady-state publishing draws without allocating
+	 *
+	 * ros::Publisher::publish(const M&) serializes the message into the outgoing queue without retaining a
+	 * reference, hence the shared pointer handed out by acquire() is dropped again once the enclosing read()
+	 * case has finished with it. A slot thereby counts as free again as soon as its use count has dropped
+	 * back to 1, i.e. as soon as the pool itself holds the only remaining reference; since the slots are
+	 * created via boost::make_shared (which co-allocates the control block with the message), reusing a slot
+	 * recycles the control block too, as opposed to merely the message. Note that the pool never shrinks:
+	 * it grows to the maximum number of messages of its type in flight at once (1 in steady state) and
+	 * stays there.
+	 */
+	template <typename MessageT>
+	class MessagePool
+	{
+		public:
+			/**
+			 * @brief Hands out a free message slot, growing the pool in case all slots are still in use
+			 *
+			 * The slot's contents are wiped beforehand s.t. no fields of its previous use can leak into
+			 * messages whose parsing only assigns a subset of the fields.
+			 * @return A smart pointer to the (empty) ROS message slot
+			 */
+			boost::shared_ptr<MessageT> acquire()
+			{
+				boost::mutex::scoped_lock lock(mutex_);
+				for (std::size_t i = 0; i < slots_.size(); ++i)
+				{
+					if (slots_[i].use_count() == 1)
+					{
+						*slots_[i] = MessageT();
+						return slots_[i];
+					}
+				}
+				slots_.push_back(boost::make_shared<MessageT>());
+				return slots_.back();
+			}
+
+			/**
+			 * @brief Like acquire(), yet hands the slot out as-is, without wiping its previous contents
+			 *
+			 * Meant for messages whose construction overwrites every field anyway, notably the
+			 * structure-of-arrays ones: the wipe of acquire() would also free the capacity their arrays
+			 * have grown to, while a mere clear() by the caller keeps it, s.t. steady-state refills
+			 * allocate nothing.
+			 * @return A smart pointer to the ROS message slot, previous contents included
+			 */
+			boost::shared_ptr<MessageT> acquireDirty()
+			{
+				boost::mutex::scoped_lock lock(mutex_);
+				for (std::size_t i = 0; i < slots_.size(); ++i)
+				{
+					if (slots_[i].use_count() == 1)
+					{
+						return slots_[i];
+					}
+				}
+				slots_.push_back(boost::make_shared<MessageT>());
+				return slots_.back();
+			}
+
+		private:
+			//! The pooled messages; the pool holds one reference to each s.t. use_count() == 1 signals a free slot
+			std::vector<boost::shared_ptr<MessageT> > slots_;
+			//! Protects slots_ against concurrent acquire() calls
+			boost::mutex mutex_;
+	};
+}
+
+#endif //MESSAGE_POOL_HPP
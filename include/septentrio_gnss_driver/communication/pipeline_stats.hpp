@@ -0,0 +1,225 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef PIPELINE_STATS_HPP
+#define PIPELINE_STATS_HPP
+
+// C++ library includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+// Boost includes
+#include <boost/chrono.hpp>
+// ROS includes
+#include <diagnostic_msgs/DiagnosticStatus.h>
+
+/**
+ * @file pipeline_stats.hpp
+ * @date 01/09/26
+ * @brief Always-on hot-path instrumentation: latency histograms and stream-health counters
+ */
+
+namespace io_comm_rx
+{
+	/**
+	 * @class PipelineStats
+	 * @brief Collects where the time goes between asyncReadSomeHandler() receiving bytes and publish() firing
+	 *
+	 * Three timestamps are taken along the pipeline: at the ring write (markIngest(), on the I/O thread), at
+	 * each search() hit (markSearchHit(), on the parser thread) and right after each publisher.publish()
+	 * (markPublish()). The latter two are aggregated into two log2-bucketed latency histograms -
+	 * ingest-to-parse and ingest-to-publish - from which quantiles are computed at export time. On top of
+	 * the histograms, the class counts CRC failures, resyncs (SBF blocks abandoned without a clean jump,
+	 * forcing the scanner to hunt for the next sync pair byte-wise) and the ring occupancy high-water mark.
+	 *
+	 * Everything is exported as one extra DiagnosticStatus appended to the DiagnosticArray the driver
+	 * publishes anyway, cf. RxMessage::DiagnosticArrayCallback().
+	 *
+	 * The overhead is meant to be low enough to stay enabled in production: the hot-path methods below are
+	 * header-inlined and boil down to one clock read plus one relaxed atomic increment each; no locks
+	 * anywhere. The counters are receiver-global (like the last_.. SBF state of the RxMessage class), i.e.
+	 * with several receiver streams (cf. the multi_receiver ROS parameters) the histograms aggregate over
+	 * all of them. Concurrent relaxed updates may lose the odd count, which for statistics is a price
+	 * happily paid for staying off the hot path's critical path.
+	 */
+	class PipelineStats
+	{
+		public:
+
+			/**
+			 * @brief Marks the arrival of a chunk of bytes, called by asyncReadSomeHandler()
+			 *
+			 * Only the !oldest! not-yet-parsed chunk's arrival is retained (the compare-exchange succeeds
+			 * solely when no earlier stamp is pending), s.t. the latency measured below includes the time a
+			 * chunk queues in the ring while the parser is busy - which is exactly the time that grows when
+			 * the pipeline falls behind.
+			 */
+			static void markIngest()
+			{
+				uint64_t expected = 0;
+				pending_ingest_ns_.compare_exchange_strong(expected, nowNS(), std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Claims the pending ingest stamp for the chunk about to be parsed, called at the top of
+			 * CallbackHandlers::readCallback()
+			 *
+			 * In case no stamp is pending (file playback and the benchmark feed readCallback() directly,
+			 * without an I/O thread), the chunk is stamped now, s.t. the histograms then show the pure
+			 * decode cost.
+			 */
+			static void markChunkStart()
+			{
+				chunk_ingest_ns_ = pending_ingest_ns_.exchange(0, std::memory_order_relaxed);
+				if (chunk_ingest_ns_ == 0) chunk_ingest_ns_ = nowNS();
+			}
+
+			//! The ingest stamp (steady clock, nanoseconds) of the chunk the calling thread currently
+			//! decodes; read by the parser thread when it copies a frame out for a decode worker, s.t.
+			//! the worker can carry the stamp along, cf. seedChunkStart()
+			static uint64_t chunkStartNS()
+			{
+				return chunk_ingest_ns_;
+			}
+
+			/**
+			 * @brief Seeds the calling thread's chunk ingest stamp with one captured elsewhere
+			 *
+			 * chunk_ingest_ns_ is thread-local and markChunkStart() only runs on the parser thread: without
+			 * re-seeding, the workers of the DecodeWorkerPool class would compute their ingest-to-publish
+			 * latencies against 0 and flood the top histogram bucket. Each worker hence calls this, with
+			 * the stamp the frame's chunk was ingested under, right before decoding the frame.
+			 * @param[in] ingest_ns The ingest stamp to seed, 0 falling back to the current time
+			 */
+			static void seedChunkStart(uint64_t ingest_ns)
+			{
+				chunk_ingest_ns_ = ingest_ns != 0 ? ingest_ns : nowNS();
+			}
+
+			//! Records the current chunk's ingest-to-parse latency, called per search() hit
+			static void markSearchHit()
+			{
+				recordLatency(parse_histogram_, nowNS() - chunk_ingest_ns_);
+			}
+
+			//! Records the current chunk's ingest-to-publish latency, called right after publisher.publish()
+			static void markPublish()
+			{
+				recordLatency(publish_histogram_, nowNS() - chunk_ingest_ns_);
+			}
+
+			//! Keeps track of the ring occupancy high-water mark, called after each ring write; the
+			//! load-then-store race between streams is benign, cf. the class description
+			static void recordRingOccupancy(std::size_t occupancy)
+			{
+				if (occupancy > ring_high_water_.load(std::memory_order_relaxed))
+				{
+					ring_high_water_.store(occupancy, std::memory_order_relaxed);
+				}
+			}
+
+			//! Counts an SBF block whose CRC check failed
+			static void countCrcFailure()
+			{
+				crc_failures_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			//! Counts a resync, i.e. an SBF block abandoned without a clean jump to the next one
+			static void countResync()
+			{
+				resyncs_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			//! Counts one overflow eviction of the receive ring and the number of oldest unread bytes it
+			//! dropped to admit newer ones, cf. the overflow policy of the SPSCRingBuffer class
+			static void countOverflow(std::size_t dropped_bytes)
+			{
+				overflow_drops_.fetch_add(1, std::memory_order_relaxed);
+				overflow_dropped_bytes_.fetch_add(dropped_bytes, std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Renders the collected statistics into one DiagnosticStatus for the DiagnosticArray
+			 * @return The status, holding the p50/p99 latencies, the high-water mark and the counters
+			 */
+			static diagnostic_msgs::DiagnosticStatus pipelineStatus();
+
+		private:
+
+			//! Number of log2 buckets, one per possible position of a latency's most significant bit
+			static const std::size_t BUCKET_COUNT = 64;
+
+			//! The current time on the monotonic clock in nanoseconds
+			static uint64_t nowNS()
+			{
+				return static_cast<uint64_t>(boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+					boost::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			//! Increments the histogram bucket holding the given latency's most significant bit
+			static void recordLatency(std::atomic<uint64_t>* histogram, uint64_t nanoseconds)
+			{
+				std::size_t bucket = 63 - __builtin_clzll(nanoseconds | 1);
+				histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Computes the given quantile from the given histogram
+			 * @param[in] histogram The histogram to walk
+			 * @param[in] quantile The quantile sought, e.g. 0.99
+			 * @return The bucket upper bound the quantile falls into, in microseconds (i.e. correct up to
+			 * the factor-of-two bucket granularity), 0 in case the histogram is empty
+			 */
+			static double quantileUS(const std::atomic<uint64_t>* histogram, double quantile);
+
+			//! Histogram of ingest-to-parse (search() hit) latencies, log2-bucketed in nanoseconds
+			static std::atomic<uint64_t> parse_histogram_[BUCKET_COUNT];
+			//! Histogram of ingest-to-publish latencies, log2-bucketed in nanoseconds
+			static std::atomic<uint64_t> publish_histogram_[BUCKET_COUNT];
+			//! Arrival stamp of the oldest not-yet-parsed chunk, 0 if all arrived chunks have been claimed
+			static std::atomic<uint64_t> pending_ingest_ns_;
+			//! Ring occupancy high-water mark in bytes
+			static std::atomic<uint64_t> ring_high_water_;
+			//! Number of SBF blocks whose CRC check failed
+			static std::atomic<uint64_t> crc_failures_;
+			//! Number of resyncs, cf. countResync()
+			static std::atomic<uint64_t> resyncs_;
+			//! Number of overflow evictions of the receive ring, cf. countOverflow()
+			static std::atomic<uint64_t> overflow_drops_;
+			//! Number of oldest unread bytes dropped by overflow evictions in total, cf. countOverflow()
+			static std::atomic<uint64_t> overflow_dropped_bytes_;
+			//! Ingest stamp of the chunk the calling thread - the parser thread, or a decode worker
+			//! re-seeded via seedChunkStart() - currently decodes; thread-local s.t. the per-message
+			//! hot-path methods need neither locks nor shared writes to find it
+			static thread_local uint64_t chunk_ingest_ns_;
+	};
+}
+
+#endif // for PIPELINE_STATS_HPP
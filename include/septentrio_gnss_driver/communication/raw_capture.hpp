@@ -0,0 +1,190 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// *****************************************************************************
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+// *****************************************************************************
+
+#ifndef RAW_CAPTURE_HPP
+#define RAW_CAPTURE_HPP
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+// Boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/mutex.hpp>
+
+/**
+ * @file raw_capture.hpp
+ * @date 01/09/26
+ * @brief Lossless raw logging of the receiver's byte stream to an on-disk ring of pre-allocated files
+ */
+
+namespace io_comm_rx
+{
+	/**
+	 * @class RawCapture
+	 * @brief Appends every received chunk to an on-disk ring of pre-allocated files, off the I/O thread
+	 *
+	 * Tee-ing the serial port outside the driver doubles the kernel read traffic, hence the capture stage
+	 * sits right inside AsyncManager::asyncReadSomeHandler() instead. The append() method only ever memcpys
+	 * the chunk into one of two in-memory buffers; a dedicated writer thread swaps the buffers and issues
+	 * large batched write()s to the current capture file, s.t. logging costs near-zero latency on the parse
+	 * path. Once a capture file exceeds its maximum size, the writer rotates to the next file of the ring
+	 * (pre-allocated via posix_fallocate() s.t. rotation never stalls on block allocation), wrapping around
+	 * and overwriting the oldest file once the ring is full. Should the disk ever fall behind both buffers,
+	 * chunks are dropped (and counted) rather than the I/O thread stalled.
+	 *
+	 * Each AsyncManager (i.e. each receiver stream) owns its own RawCapture instance writing its own file
+	 * ring, s.t. multi-receiver captures do not interleave mid-message and each file replays cleanly via the
+	 * file:// playback mode.
+	 */
+	class RawCapture
+	{
+		public:
+
+			/**
+			 * @brief Stores the capture configuration, to be read from the raw_capture/.. ROS parameters
+			 *
+			 * Must be called before the first createIfEnabled() call in order to take effect, i.e. before
+			 * the first stream is initialized.
+			 * @param[in] enabled Whether raw capture is enabled at all
+			 * @param[in] directory The directory the capture files are placed in
+			 * @param[in] max_file_size_mb Size in MiB at which the writer rotates to the ring's next file
+			 * @param[in] file_count Number of files in the ring, the oldest being overwritten once it is full
+			 */
+			static void configure(bool enabled, const std::string& directory, std::size_t max_file_size_mb,
+				std::size_t file_count);
+
+			/**
+			 * @brief Creates a RawCapture instance in case capture was enabled via configure()
+			 * @return A smart pointer to the new instance, or an empty one in case capture is disabled
+			 */
+			static boost::shared_ptr<RawCapture> createIfEnabled();
+
+			/**
+			 * @brief Class destructor: flushes the buffered remainder and joins the writer thread
+			 */
+			~RawCapture();
+
+			/**
+			 * @brief Appends one received chunk to the capture, called on the I/O thread
+			 *
+			 * Merely memcpys into the in-memory buffer currently being filled and pokes the writer thread;
+			 * never blocks on the disk. In case both buffers are full (i.e. the disk cannot keep up), the
+			 * chunk is dropped and counted.
+			 * @param[in] data Pointer to the chunk's first byte
+			 * @param[in] size Number of bytes in the chunk
+			 */
+			void append(const uint8_t* data, std::size_t size);
+
+		private:
+
+			/**
+			 * @brief Class constructor, only reachable via createIfEnabled()
+			 * @param[in] instance_id Running number distinguishing the file rings of concurrent streams
+			 */
+			explicit RawCapture(std::size_t instance_id);
+
+			//! Loop of the writer thread: swaps the buffers and writes the full one to the current file
+			void writeLoop();
+
+			//! Opens (and pre-allocates) the capture file of the given ring slot, closing the previous one
+			void openFile(std::size_t ring_slot);
+
+			//! Whether raw capture was enabled via configure()
+			static bool enabled_;
+			//! The directory the capture files are placed in
+			static std::string directory_;
+			//! Size in bytes at which the writer rotates to the ring's next file
+			static std::size_t max_file_size_;
+			//! Number of files in the ring
+			static std::size_t file_count_;
+			//! Hands each instance its running number, cf. the constructor
+			static std::size_t instance_counter_;
+
+			//! Running number distinguishing the file rings of concurrent streams
+			std::size_t instance_id_;
+			//! The two buffers append() and the writer thread ping-pong between
+			std::vector<uint8_t> buffers_[2];
+			//! Fill level of each of the two buffers
+			std::size_t fill_[2];
+			//! Index of the buffer append() currently fills; the writer thread drains the other one
+			std::size_t active_;
+			//! Number of bytes dropped because both buffers were full, merely for the shutdown report
+			std::size_t dropped_bytes_;
+			//! Protects the buffer bookkeeping above; only ever held for a memcpy or an index swap,
+			//! never across a write() to disk
+			boost::mutex mutex_;
+			//! Pokes the writer thread whenever there are bytes to be written
+			boost::condition_variable write_condition_;
+			//! Whether the destructor asked the writer thread to flush and finish
+			bool stopping_;
+			//! File descriptor of the current capture file, -1 in case opening failed
+			int fd_;
+			//! Number of bytes written to the current capture file so far
+			std::size_t bytes_in_file_;
+			//! Ring slot of the current capture file
+			std::size_t ring_slot_;
+			//! The writer thread draining the buffers to disk
+			boost::shared_ptr<boost::thread> write_thread_;
+	};
+}
+
+#endif // for RAW_CAPTURE_HPP
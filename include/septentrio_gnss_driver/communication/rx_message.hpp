@@ -108,15 +108,20 @@
 
 // C++ libraries
 #include <cstddef>
+#include <cstring>
 #include <sstream>
 #include <map>
+#include <vector>
 #include <cassert> // for assert
 // Boost includes
 #include <boost/tokenizer.hpp>
 #include <boost/call_traits.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/format.hpp>
 #include <boost/math/constants/constants.hpp>
 // ROS includes
+#include <ros/serialization.h>
+#include <ros/message_traits.h>
 #include <sensor_msgs/NavSatFix.h>
 #include <sensor_msgs/TimeReference.h>
 #include <geometry_msgs/PoseWithCovarianceStamped.h>
@@ -124,6 +129,8 @@
 #include <diagnostic_msgs/DiagnosticStatus.h>
 #include <gps_common/GPSFix.h>
 // ROSaic includes
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
+#include <septentrio_gnss_driver/communication/pipeline_stats.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
@@ -136,6 +143,9 @@
 #include <septentrio_gnss_driver/PosCovGeodetic.h>
 #include <septentrio_gnss_driver/AttEuler.h>
 #include <septentrio_gnss_driver/AttCovEuler.h>
+#include <septentrio_gnss_driver/MeasEpoch.h>
+#include <septentrio_gnss_driver/ChannelStatus.h>
+#include <septentrio_gnss_driver/RawBlock.h>
 
 #ifndef RX_MESSAGE_HPP
 #define RX_MESSAGE_HPP
@@ -147,25 +157,11 @@
  */
  
 extern bool g_use_gnss_time;
+extern bool g_publish_measepoch;
+extern bool g_publish_channelstatus;
 extern bool g_read_cd;
 extern uint32_t g_cd_count;
 extern uint32_t g_leap_seconds;
-extern bool g_channelstatus_has_arrived_gpsfix;
-extern bool g_measepoch_has_arrived_gpsfix;
-extern bool g_dop_has_arrived_gpsfix;
-extern bool g_pvtgeodetic_has_arrived_gpsfix;
-extern bool g_pvtgeodetic_has_arrived_navsatfix;
-extern bool g_pvtgeodetic_has_arrived_pose;
-extern bool g_poscovgeodetic_has_arrived_gpsfix;
-extern bool g_poscovgeodetic_has_arrived_navsatfix;
-extern bool g_poscovgeodetic_has_arrived_pose;
-extern bool g_velcovgeodetic_has_arrived_gpsfix;
-extern bool g_atteuler_has_arrived_gpsfix;
-extern bool g_atteuler_has_arrived_pose;
-extern bool g_attcoveuler_has_arrived_gpsfix;
-extern bool g_attcoveuler_has_arrived_pose;
-extern bool g_receiverstatus_has_arrived_diagnostics;
-extern bool g_qualityind_has_arrived_diagnostics;
 extern boost::shared_ptr<ros::NodeHandle> g_nh;
 extern const uint32_t g_ROS_QUEUE_SIZE;
 
@@ -175,24 +171,272 @@ enum TypeOfPVT_Enum {evNoPVT, evStandAlone, evDGPS, evFixed, evRTKFixed, evRTKFl
 
 //! Since switch only works with int (yet NMEA message IDs are strings), we need enum.
 //! Note drawbacks: No variable can have a name which is already in some enumeration, enums are not type safe etc..
-enum RxID_Enum {evNavSatFix, evGPSFix, evPoseWithCovarianceStamped, evGPGGA, evGPRMC, evGPGSA, evGPGSV, evGLGSV, 
-	evGAGSV, evPVTCartesian, evPVTGeodetic, evPosCovCartesian, evPosCovGeodetic, evAttEuler, evAttCovEuler, evGPST, 
-	evChannelStatus, evMeasEpoch, evDOP, evVelCovGeodetic, evDiagnosticArray, evReceiverStatus, evQualityInd, 
-	evReceiverSetup};
+enum RxID_Enum {evNavSatFix, evGPSFix, evPoseWithCovarianceStamped, evGPGGA, evGPRMC, evGPGSA, evGPGSV, evGLGSV,
+	evGAGSV, evPVTCartesian, evPVTGeodetic, evPosCovCartesian, evPosCovGeodetic, evAttEuler, evAttCovEuler, evGPST,
+	evChannelStatus, evMeasEpoch, evDOP, evVelCovGeodetic, evDiagnosticArray, evReceiverStatus, evQualityInd,
+	evReceiverSetup, evRxIDUnknown};
+
+//! Numeric message ID used as key throughout the dispatch path. SBF blocks simply use the block number found
+//! in their header (e.g. 4007 for PVTGeodetic), which occupies the lower 13 bits of a uint16_t anyway. Messages
+//! that do not stem from a single SBF block (NMEA sentences and the composite ROS messages assembled from
+//! several blocks) are assigned synthetic IDs above the 13-bit block number range s.t. both kinds can share
+//! one key type and string comparisons vanish from the hot path.
+typedef uint16_t RxIDType;
+
+//! Synthetic message IDs of the NMEA sentences, cf. the note above RxIDType
+const RxIDType RX_ID_GPGGA = 8192;
+const RxIDType RX_ID_GPRMC = 8193;
+const RxIDType RX_ID_GPGSA = 8194;
+const RxIDType RX_ID_GPGSV = 8195;
+const RxIDType RX_ID_GLGSV = 8196;
+const RxIDType RX_ID_GAGSV = 8197;
+const RxIDType RX_ID_GBGSV = 8198;
+//! Synthetic message IDs of the composite ROS messages that are assembled from multiple SBF blocks
+const RxIDType RX_ID_NAVSATFIX = 8256;
+const RxIDType RX_ID_GPSFIX = 8257;
+const RxIDType RX_ID_POSEWITHCOVARIANCESTAMPED = 8258;
+const RxIDType RX_ID_GPST = 8259;
+const RxIDType RX_ID_DIAGNOSTICARRAY = 8260;
+//! Synthetic ID under which the single publisher of the raw SBF block passthrough is filed: the raw
+//! handlers are registered per block ID, yet all publish onto one topic, and the decoded counterpart of a
+//! block keeps its own publisher slot under the plain block number
+const RxIDType RX_ID_RAWBLOCK = 8261;
+//! Returned by RxMessage::messageNumber() whenever data_ does not point to a known SBF block or NMEA sentence
+const RxIDType RX_ID_UNKNOWN = 0;
+//! Covers the 13-bit SBF block number range plus the synthetic IDs above; array-based dispatch structures
+//! use it as their size s.t. any valid RxIDType can index them directly
+const std::size_t RX_ID_TABLE_SIZE = 8448;
+
+//! Maximum number of receiver streams (primary plus secondary receivers) one node can ingest; per-stream
+//! array-based structures such as the publisher registry are sized with it
+const std::size_t MAX_RX_STREAMS = 4;
 
 namespace io_comm_rx
 {
 	/**
 	 * @brief Calculates the timestamp, in the Unix Epoch time format
-	 * This is either done using the TOW as transmitted with the SBF block (if "use_gnss" is true), or using 
-	 * the current time.
+	 * This is either done using the TOW/WNc pair as transmitted with the SBF block (if "use_gnss" is true),
+	 * or using the current time. The Unix time of the start of the GPS week only changes when the week
+	 * number (or the configured leap seconds) does, hence it is cached and per-block stamping reduces to
+	 * one division of the TOW - at full millisecond precision, which the former UTC-string detour
+	 * truncated to hundredths of a second.
 	 * @param[in] tow (Time of Week) Number of milliseconds that elapsed since the beginning of the current 
 	 * GPS week as transmitted by the SBF block
-	 * @param[in] use_gnss If true, the TOW as transmitted with the SBF block is used, otherwise the current time
+	 * @param[in] wnc (Week Number counter) Number of full weeks that elapsed since January 6, 1980, as
+	 * transmitted by the SBF block
+	 * @param[in] use_gnss If true, the TOW/WNc pair as transmitted with the SBF block is used, otherwise
+	 * the current time
 	 * @return ros::Time object containing seconds and nanoseconds since last epoch
 	 */
-	ros::Time timestampSBF(uint32_t tow, bool use_gnss);
-	
+	ros::Time timestampSBF(uint32_t tow, uint16_t wnc, bool use_gnss);
+
+	/**
+	 * @brief Scans the interval [data, data + count) for the first byte pair that starts a recognizable message
+	 *
+	 * Candidate start bytes ($ always, I whenever connection descriptors are expected) are located via
+	 * 16-byte-wide SSE2 compares where available and memchr otherwise, s.t. buffers polluted with other binary
+	 * traffic (e.g. an interleaved corrections stream on a shared port) are skipped at vector speed rather than
+	 * one byte at a time. Used by RxMessage::search(), yet freestanding s.t. other ingest paths can reuse it.
+	 * @param[in] data Pointer to the first byte of the interval to be scanned
+	 * @param[in] count Number of bytes in the interval
+	 * @param[in] read_cd Whether connection descriptors ("IP..") shall be recognized too
+	 * @return Pointer to the first recognized sync pair, or data + count in case there is none
+	 */
+	const uint8_t* scanForSyncPair(const uint8_t* data, std::size_t count, bool read_cd);
+
+	/**
+	 * @class PublishSink
+	 * @brief Type-erased consumer the PublisherRegistry class can divert all published messages to
+	 *
+	 * Meant for tools that run the decode pipeline without a ROS master, such as the SBF-to-rosbag
+	 * converter: each message a read() case would have published arrives here in ROS-serialized form
+	 * instead, together with the type metadata needed to reconstruct (or record) it.
+	 */
+	class PublishSink
+	{
+		public:
+			virtual ~PublishSink() {}
+
+			/**
+			 * @brief Takes over one published message
+			 * @param[in] topic The topic the message would have been published on, topic prefix included
+			 * @param[in] stamp The message's header stamp, or the current time for headerless messages
+			 * @param[in] md5sum The MD5 sum of the message's type, cf. ros::message_traits
+			 * @param[in] datatype The name of the message's type, e.g. "septentrio_gnss_driver/PVTGeodetic"
+			 * @param[in] definition The full message definition text of the message's type
+			 * @param[in] bytes Pointer to the ROS-serialized message body, only valid during the call
+			 * @param[in] size Number of bytes of the ROS-serialized message body
+			 */
+			virtual void handle(const std::string& topic, const ros::Time& stamp,
+				const std::string& md5sum, const std::string& datatype, const std::string& definition,
+				const uint8_t* bytes, uint32_t size) = 0;
+	};
+
+	/**
+	 * @class PublisherRegistry
+	 * @brief Holds all ROS publishers of the driver in a flat array indexed by the numeric message ID
+	 *
+	 * The publishers used to be function-local statics inside RxMessage::read(), meaning each message type
+	 * paid the advertise latency (plus a guard variable check per call) upon its first occurrence in the
+	 * stream - right when the first fix is at stake. Advertising instead happens up front via advertise(),
+	 * which ROSaicNode::defineMessages() calls next to the respective handler insertions, s.t. publish()
+	 * finds a ready publisher by the same key the dispatch table is indexed with. Should a message type
+	 * ever reach publish() without having been advertised (e.g. a read() case added without its
+	 * defineMessages() counterpart), the publisher is created on the spot rather than the message dropped.
+	 *
+	 * One table of publishers exists per receiver stream, s.t. a node ingesting several receivers (cf. the
+	 * multi_receiver ROS parameters) publishes each receiver's messages under its own topic prefix. Stream 0
+	 * is the primary receiver publishing without prefix, exactly as a single-receiver node always did.
+	 *
+	 * The node handle all topics are advertised on is injected up front via setNodeHandle(), by whichever
+	 * entry point hosts the driver: main() hands over the node's own handle, the nodelet (cf. the
+	 * ROSaicNodelet class) its private nodelet handle together with the intra_process flag. With the flag
+	 * set, publish() hands roscpp a shared pointer rather than a reference, s.t. subscribers living in the
+	 * same nodelet manager receive the very message object - no serialization, no loopback copy, no
+	 * deserialization - which at 100 Hz output rates is a measurable slice of a core.
+	 */
+	class PublisherRegistry
+	{
+		public:
+			/**
+			 * @brief Advertises the given topic and files the resulting publisher under the given key,
+			 * for the primary receiver stream
+			 * @param[in] key Numeric message ID whose read() case publishes on the topic
+			 * @param[in] topic The topic to advertise, e.g. "/pvtgeodetic"
+			 */
+			template <typename MessageT>
+			static void advertise(RxIDType key, const std::string& topic)
+			{
+				advertise<MessageT>(0, key, topic);
+			}
+
+			/**
+			 * @brief Advertises the given topic and files the resulting publisher under the given key
+			 * @param[in] stream_id The receiver stream the publisher belongs to, 0 being the primary receiver
+			 * @param[in] key Numeric message ID whose read() case publishes on the topic
+			 * @param[in] topic The topic to advertise, topic prefix included, e.g. "/aux1/pvtgeodetic"
+			 */
+			template <typename MessageT>
+			static void advertise(std::size_t stream_id, RxIDType key, const std::string& topic)
+			{
+				boost::mutex::scoped_lock lock(mutex_);
+				publishers_[stream_id][key] = nh_->advertise<MessageT>(topic, g_ROS_QUEUE_SIZE);
+			}
+
+			/**
+			 * @brief Publishes the given message via the publisher filed under the given stream and key
+			 *
+			 * The "topic_prefix" and "topic" arguments are only consulted on the cold path, i.e. in case the
+			 * stream/key combination was never advertise()d, cf. the class description; notably the string
+			 * concatenation of the two does not happen on the hot path.
+			 * @param[in] stream_id The receiver stream the message stems from, 0 being the primary receiver
+			 * @param[in] key Numeric message ID the publisher was filed under
+			 * @param[in] topic_prefix The stream's topic prefix, empty for the primary receiver
+			 * @param[in] topic The topic to advertise in case the stream/key combination was not advertised up front
+			 * @param[in] message The ROS message to publish
+			 */
+			template <typename MessageT>
+			static void publish(std::size_t stream_id, RxIDType key, const std::string& topic_prefix,
+				const char* topic, const MessageT& message)
+			{
+				if (sink_ != NULL)
+				{
+					// The sink path, cf. divert(): the message is serialized once - exactly as
+					// roscpp would for a real publish - and handed over with its type metadata, no
+					// ROS master involved. Messages carrying a header are filed under their header
+					// stamp, s.t. e.g. a bag record reflects measurement time.
+					uint32_t length = ros::serialization::serializationLength(message);
+					std::vector<uint8_t> buffer(length);
+					ros::serialization::OStream stream(buffer.data(), length);
+					ros::serialization::serialize(stream, message);
+					const ros::Time* header_stamp = ros::message_traits::TimeStamp<MessageT>::pointer(message);
+					sink_->handle(topic_prefix + topic,
+						header_stamp != NULL ? *header_stamp : ros::Time::now(),
+						ros::message_traits::md5sum<MessageT>(), ros::message_traits::datatype<MessageT>(),
+						ros::message_traits::definition<MessageT>(), buffer.data(), length);
+					return;
+				}
+				if (stubbed_) return;
+				ros::Publisher& publisher = publishers_[stream_id][key];
+				if (publisher.getTopic().empty())
+				{
+					advertise<MessageT>(stream_id, key, topic_prefix + topic);
+				}
+				if (intra_process_)
+				{
+					// Shared-pointer publishing: subscribers within the same process receive the very
+					// message object with zero serialization. One copy is still made here, since read()
+					// reuses its message objects (cf. e.g. the last_.. members of the RxMessage class)
+					// across epochs, whereas a pointer, once handed to roscpp, must never be mutated again.
+					publisher.publish(boost::make_shared<MessageT>(message));
+				}
+				else
+				{
+					publisher.publish(message);
+				}
+				PipelineStats::markPublish();
+			}
+
+			/**
+			 * @brief Turns all subsequent publish() calls into no-ops
+			 *
+			 * Solely meant for the benchmark executable, which pumps recorded streams through the decode
+			 * pipeline without a ROS master: the messages are still fully constructed by read(), only the
+			 * final handover to roscpp is skipped.
+			 */
+			static void stub()
+			{
+				stubbed_ = true;
+			}
+
+			/**
+			 * @brief Diverts all subsequent publish() calls to the given sink instead of roscpp
+			 *
+			 * Cf. the PublishSink class; NULL restores the normal publishing behavior. Meant to be set
+			 * up front by tools like the SBF-to-rosbag converter, before any decoding starts: the sink
+			 * is invoked from whichever thread decodes, synchronization (if needed) is the sink's business.
+			 * @param[in] sink The sink to divert to, not owned by the registry
+			 */
+			static void divert(PublishSink* sink)
+			{
+				sink_ = sink;
+			}
+
+			/**
+			 * @brief Injects the node handle all topics are advertised on
+			 *
+			 * Must be called before the first advertise() call, i.e. before ROSaicNode is constructed.
+			 * @param[in] nh The node handle to advertise on: the node's own handle when running standalone,
+			 * the private nodelet handle when running inside a nodelet manager
+			 * @param[in] intra_process Whether publish() shall hand roscpp shared pointers instead of
+			 * references, enabling zero-serialization message passing to subscribers within the same
+			 * process; only sensible inside a nodelet manager, cf. the class description
+			 */
+			static void setNodeHandle(const boost::shared_ptr<ros::NodeHandle>& nh, bool intra_process = false)
+			{
+				nh_ = nh;
+				intra_process_ = intra_process;
+			}
+
+		private:
+			//! The publishers, indexed by receiver stream and numeric message ID; a default-constructed
+			//! entry means "not advertised"
+			static std::vector<std::vector<ros::Publisher>> publishers_;
+			//! Serializes advertise() calls; publish() itself runs unlocked on the hot path, which is safe
+			//! since a key's handler is only inserted (and hence its read() case only reached) after its
+			//! advertise() call has completed
+			static boost::mutex mutex_;
+			//! Whether publish() is a no-op, cf. stub()
+			static bool stubbed_;
+			//! Sink all publish() calls are diverted to, NULL (the default) meaning none, cf. divert()
+			static PublishSink* sink_;
+			//! The node handle all topics are advertised on, cf. setNodeHandle()
+			static boost::shared_ptr<ros::NodeHandle> nh_;
+			//! Whether publish() hands roscpp shared pointers for zero-serialization intra-process
+			//! message passing, cf. setNodeHandle()
+			static bool intra_process_;
+	};
+
 	/**
 	 * @class RxMessage
 	 * @brief Can search buffer for messages, read/parse them, and so on
@@ -209,8 +453,12 @@ namespace io_comm_rx
 			 * removing it (not even reinterpret_cast)
 			 * @param[in] data Pointer to the buffer that is about to be analyzed
 			 * @param[in] size Size of the buffer (as handed over by async_read_some)
+			 * @param[in] stream_id The receiver stream the buffer stems from, 0 being the primary receiver
+			 * @param[in] topic_prefix The stream's topic prefix, empty for the primary receiver
 			 */
-			RxMessage(const uint8_t* data, std::size_t& size): data_(data), count_(size) 
+			RxMessage(const uint8_t* data, std::size_t& size, std::size_t stream_id = 0,
+				const std::string& topic_prefix = std::string()): data_(data), count_(size),
+				stream_id_(stream_id), topic_prefix_(topic_prefix)
 			{found_ = false; crc_check_ = false; message_size_ = 0;}
 			
 			//! Determines whether data_ points to the SBF block with ID "ID", e.g. 5003
@@ -230,9 +478,14 @@ namespace io_comm_rx
 			bool isErrorMessage();
 			//! Determines size of the message (also command reply) that data_ is currently pointing at
 			std::size_t messageSize();
-			//! Returns the message ID of the message where data_ is pointing at at the moment, SBF 
+			//! Returns the message ID of the message where data_ is pointing at at the moment as a number:
+			//! the SBF block number for SBF blocks and one of the synthetic RX_ID_.. constants for NMEA
+			//! sentences, RX_ID_UNKNOWN otherwise
+			RxIDType messageNumber();
+			//! Returns the message ID of the message where data_ is pointing at at the moment, SBF
 			//! identifiers embellished with inverted commas, e.g. "5003"
-			std::string messageID(); 
+			//! Only meant for logging; the dispatch path operates on messageNumber() throughout
+			std::string messageID();
 			
 			/**
 			 * @brief Returns the count_ variable
@@ -253,7 +506,54 @@ namespace io_comm_rx
 			 * @return The length of the SBF block
 			 */
 			uint16_t getBlockLength();
-			
+
+			/**
+			 * @brief Gets the time of week of the SBF block's time stamp field, in milliseconds
+			 *
+			 * Only meaningful while data_ points to a (complete) SBF block.
+			 * @return The time of week, possibly the Do-Not-Use value 4294967295
+			 */
+			uint32_t getTow();
+
+			/**
+			 * @brief Gets the week number counter of the SBF block's time stamp field
+			 *
+			 * Only meaningful while data_ points to a (complete) SBF block.
+			 * @return The week number counter, possibly the Do-Not-Use value 65535
+			 */
+			uint16_t getWnc();
+
+			/**
+			 * @brief Hands over the wire-arrival time of the frame data_ points to, cf. the ingest stamp
+			 * journal of the AsyncManager class; a zero time means none is available (file playback,
+			 * benchmark), in which case messageStamp() samples the clock itself
+			 */
+			void setIngestStamp(const ros::Time& ingest_stamp) { ingest_stamp_ = ingest_stamp; }
+
+			/**
+			 * @brief The time stamp the published ROS messages of the current frame shall carry
+			 *
+			 * With use_gnss_time being true this is the GNSS time of the given TOW/WNc pair, cf.
+			 * timestampSBF(); otherwise it is the frame's wire-arrival time as handed over via
+			 * setIngestStamp(), s.t. the stamp reflects when the data entered the machine rather than when
+			 * its decoding happened to complete.
+			 * @param[in] tow (Time of Week) in milliseconds, as transmitted by the SBF block
+			 * @param[in] wnc (Week Number counter), as transmitted by the SBF block
+			 * @return ros::Time object containing seconds and nanoseconds since last epoch
+			 */
+			ros::Time messageStamp(uint32_t tow, uint16_t wnc);
+
+			/**
+			 * @brief Validates the CRC of the SBF block data_ currently points to
+			 *
+			 * The outcome is memoized in crc_check_, which next() consults: a block failing its CRC cannot
+			 * be trusted about its own length, hence the scanner falls back to hunting for the next sync
+			 * pair byte-wise. Failures are counted by the PipelineStats class. Only meaningful while data_
+			 * points to a complete SBF block.
+			 * @return True if the block's CRC field matches its contents
+			 */
+			bool checkCrc();
+
 			/**
 			 * @brief Gets the current position in the read buffer
 			 * @return The current position of the read buffer
@@ -280,11 +580,26 @@ namespace io_comm_rx
 			
 			/**
 			 * @brief Performs the CRC check (if SBF) and populates ROS message "message" with the necessary content
+			 *
+			 * If publish_only is true, the argument "message" is left untouched: The freshly decoded message is
+			 * merely published and the (potentially sizeable, think gps_common::GPSFix) copy into "message" is
+			 * skipped. Only the blocking Wait()/Get() path of the CallbackHandler class ever consumes that copy.
 			 * @return True if read was successful, false otherwise
 			 */
 			template <typename T>
-			bool read(typename boost::call_traits<T>::reference message, std::string message_key, bool search = false); 
-			
+			bool read(typename boost::call_traits<T>::reference message, RxIDType message_key, bool search = false, bool publish_only = false);
+
+			/**
+			 * @brief Publishes the SBF block currently pointed to as a raw byte-array message, with zero decoding
+			 *
+			 * The block's bytes are copied verbatim (header and CRC included) into a
+			 * septentrio_gnss_driver::RawBlock message; only its block header is lifted into dedicated fields,
+			 * s.t. subscribers can filter without re-parsing. Cf. the RawBlockCallbackHandler class and the
+			 * publish/raw_sbf_ids parameter.
+			 * @param[in] message_key Numeric message ID the raw publisher was registered under
+			 */
+			void publishRawBlock(RxIDType message_key);
+
 			/**
 			 * @brief Whether or not a message has been found
 			 */
@@ -300,8 +615,20 @@ namespace io_comm_rx
 			/**
 			 * @brief Number of unread bytes in the buffer
 			 */
-			std::size_t count_; 
-			
+			std::size_t count_;
+
+			/**
+			 * @brief The receiver stream the buffer stems from, 0 being the primary receiver; indexes the
+			 * publisher registry
+			 */
+			std::size_t stream_id_;
+
+			/**
+			 * @brief The stream's topic prefix, empty for the primary receiver; only consulted in case a
+			 * publisher was not advertised up front
+			 */
+			std::string topic_prefix_;
+
 			/**
 			 * @brief Whether the CRC check as evaluated in the read() method was successful or not is stored here
 			 */
@@ -311,6 +638,12 @@ namespace io_comm_rx
 			 * @brief Helps to determine size of response message / NMEA message / SBF block
 			 */
 			std::size_t message_size_;
+
+			/**
+			 * @brief Wire-arrival time of the frame data_ points to, zero if none is available;
+			 * cf. setIngestStamp()
+			 */
+			ros::Time ingest_stamp_;
 			
 			/**
 			 * @brief Number of times the gps_common::GPSFix message has been published
@@ -380,16 +713,14 @@ namespace io_comm_rx
 			 */
 			static TypeOfPVTMap type_of_pvt_map;
 			
-			//! Shorthand for the map responsible for matching ROS message identifiers to an enum value
-			typedef std::map<std::string, RxID_Enum> RxIDMap;
-			
 			/**
-			 * @brief All instances of the RxMessage class shall have access to the map without reinitializing it, hence static
-			 * 
-			 * This map is for mapping ROS message, SBF and NMEA identifiers to an enumeration and makes the switch-case
-			 * formalism in rx_message.hpp more explicit. 
+			 * @brief Matches a numeric message ID to an enum value and makes the switch-case formalism in
+			 * rx_message.hpp more explicit
+			 *
+			 * Being a plain switch, the compiler turns it into a jump table; the std::map lookup (including
+			 * the string comparisons its ordering entailed) of old is gone from the hot path.
 			 */
-			static RxIDMap rx_id_map;
+			static RxID_Enum idToEnum(RxIDType id);
 			
 			/**
 			 * @brief Callback function when reading PVTCartesian blocks
@@ -456,7 +787,19 @@ namespace io_comm_rx
 			 * @return A smart pointer to the ROS message diagnostic_msgs::DiagnosticArray just created
 			 */
 			diagnostic_msgs::DiagnosticArrayPtr DiagnosticArrayCallback();
-			
+
+			/**
+			 * @brief "Callback" function when constructing MeasEpoch messages
+			 * @return A smart pointer to the ROS message MeasEpoch just created
+			 */
+			septentrio_gnss_driver::MeasEpochPtr MeasEpochCallback();
+
+			/**
+			 * @brief "Callback" function when constructing ChannelStatus messages
+			 * @return A smart pointer to the ROS message ChannelStatus just created
+			 */
+			septentrio_gnss_driver::ChannelStatusPtr ChannelStatusCallback();
+
 	};
 	
 	
@@ -474,173 +817,126 @@ namespace io_comm_rx
 	 * Luckily, when parsing we do not care since we just search for <LF><CR>.
 	 */
 	template <typename T>
-	bool RxMessage::read(typename boost::call_traits<T>::reference message, std::string message_key, bool search) 
+	bool RxMessage::read(typename boost::call_traits<T>::reference message, RxIDType message_key, bool search, bool publish_only)
 	{
 		if (search) this->search();
 		if (!found()) return false; 
 		if (this->isSBF())
 		{
 			// If the CRC check is unsuccessful, throw an error message.
-			crc_check_ = isValid(data_);
-			if (!crc_check_)
+			if (!checkCrc())
 			{
 				throw std::runtime_error("CRC Check returned False. Not a valid data block, perhaps noisy. Ignore..");
 			}
 		}
-		switch(rx_id_map[message_key])
+		switch(idToEnum(message_key))
 		{
 			case evPVTCartesian: // Position and velocity in XYZ
 			{	// The curly bracket here is crucial: Declarations inside a block remain inside, and will die at
 				// the end of the block. Otherwise variable overloading etc.
-				septentrio_gnss_driver::PVTCartesianPtr msg = boost::make_shared<septentrio_gnss_driver::PVTCartesian>();
 				PVTCartesian pvtcartesian;
 				memcpy(&pvtcartesian, data_, sizeof(pvtcartesian));
-				msg = PVTCartesianCallback(pvtcartesian);
+				septentrio_gnss_driver::PVTCartesianPtr msg = PVTCartesianCallback(pvtcartesian);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 4006;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::PVTCartesian>("/pvtcartesian", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/pvtcartesian", *msg);
 				break;
 			}
 			case evPVTGeodetic: // Position and velocity in geodetic coordinate frame (ENU frame)
 			{
-				septentrio_gnss_driver::PVTGeodeticPtr msg = boost::make_shared<septentrio_gnss_driver::PVTGeodetic>();
 				memcpy(&last_pvtgeodetic_, data_, sizeof(last_pvtgeodetic_));
-				msg = PVTGeodeticCallback(last_pvtgeodetic_);
+				septentrio_gnss_driver::PVTGeodeticPtr msg = PVTGeodeticCallback(last_pvtgeodetic_);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 4007;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_pvtgeodetic_has_arrived_gpsfix = true;
-				g_pvtgeodetic_has_arrived_navsatfix = true;
-				g_pvtgeodetic_has_arrived_pose = true;
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::PVTGeodetic>("/pvtgeodetic", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/pvtgeodetic", *msg);
 				break;
 			}
 			case evPosCovCartesian:
 			{
-				septentrio_gnss_driver::PosCovCartesianPtr msg = boost::make_shared<septentrio_gnss_driver::PosCovCartesian>();
 				PosCovCartesian poscovcartesian;
 				memcpy(&poscovcartesian, data_, sizeof(poscovcartesian));
-				msg = PosCovCartesianCallback(poscovcartesian);
+				septentrio_gnss_driver::PosCovCartesianPtr msg = PosCovCartesianCallback(poscovcartesian);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 5905;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::PosCovCartesian>("/poscovcartesian", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/poscovcartesian", *msg);
 				break;
 			}
 			case evPosCovGeodetic:
 			{
-				septentrio_gnss_driver::PosCovGeodeticPtr msg = boost::make_shared<septentrio_gnss_driver::PosCovGeodetic>();
 				memcpy(&last_poscovgeodetic_, data_, sizeof(last_poscovgeodetic_));
-				msg = PosCovGeodeticCallback(last_poscovgeodetic_);
+				septentrio_gnss_driver::PosCovGeodeticPtr msg = PosCovGeodeticCallback(last_poscovgeodetic_);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 5906;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_poscovgeodetic_has_arrived_gpsfix = true;
-				g_poscovgeodetic_has_arrived_navsatfix = true;
-				g_poscovgeodetic_has_arrived_pose = true;
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::PosCovGeodetic>("/poscovgeodetic", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/poscovgeodetic", *msg);
 				break;
 			}
 			case evAttEuler:
 			{
-				septentrio_gnss_driver::AttEulerPtr msg = boost::make_shared<septentrio_gnss_driver::AttEuler>();
 				memcpy(&last_atteuler_, data_, sizeof(last_atteuler_));
-				msg = AttEulerCallback(last_atteuler_);
+				septentrio_gnss_driver::AttEulerPtr msg = AttEulerCallback(last_atteuler_);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 5938;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_atteuler_has_arrived_gpsfix = true;
-				g_atteuler_has_arrived_pose = true;
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::AttEuler>("/atteuler", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/atteuler", *msg);
 				break;
 			}
 			case evAttCovEuler:
 			{
-				septentrio_gnss_driver::AttCovEulerPtr msg = boost::make_shared<septentrio_gnss_driver::AttCovEuler>();
 				memcpy(&last_attcoveuler_, data_, sizeof(last_attcoveuler_));
-				msg = AttCovEulerCallback(last_attcoveuler_);
+				septentrio_gnss_driver::AttCovEulerPtr msg = AttCovEulerCallback(last_attcoveuler_);
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->block_header.id = 5939;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_attcoveuler_has_arrived_gpsfix = true;
-				g_attcoveuler_has_arrived_pose = true;
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::AttCovEuler>("/attcoveuler", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/attcoveuler", *msg);
 				break;
 			}
 			case evGPST:
 			{
-				sensor_msgs::TimeReferencePtr msg = boost::make_shared<sensor_msgs::TimeReference>();
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
+				static MessagePool<sensor_msgs::TimeReference> pool;
+				sensor_msgs::TimeReferencePtr msg = pool.acquire();
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, true); // We need the GPS time, hence true
+				time_obj = timestampSBF(this->getTow(), this->getWnc(), true); // We need the GPS time, hence true
 				msg->time_ref.sec = time_obj.sec;
 				msg->time_ref.nsec = time_obj.nsec;
 				msg->source = "GPST";
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<sensor_msgs::TimeReference>("/gpst", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gpst", *msg);
 				break;
 			}
 			case evGPGGA:
 			{
-				boost::char_separator<char> sep("\r");
-				typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
-				std::size_t nmea_size = this->messageSize();
-				std::string block_in_string(reinterpret_cast<const char*>(data_), nmea_size);
-				tokenizer tokens(block_in_string, sep);
-				
-				std::string id = this->messageID();
-				std::string one_message = *tokens.begin();
-				// No kept delimiters, hence "". Also, we specify that empty tokens should show up in the output 
-				// when two delimiters are next to each other.
-				// Hence we also append the checksum part of the GGA message to "body" below, though it is not parsed.
-				boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens); 
-				tokenizer tokens_2(one_message, sep_2);
-				std::vector<std::string> body;
-				for (tokenizer::iterator tok_iter = tokens_2.begin(); tok_iter != tokens_2.end(); ++tok_iter) 
-				{
-					body.push_back(*tok_iter);
-				}
-				// Create NmeaSentence struct to pass to GpggaParser::parseASCII
-				NMEASentence gga_message(id, body);
-				septentrio_gnss_driver::GpggaPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgga>();
+				// Create NMEASentence to pass to GpggaParser::parseASCII; its fields, the ID at index 0 and the
+				// (never parsed) checksum at the end included, are mere views into the read buffer behind data_.
+				NMEASentence gga_message(reinterpret_cast<const char*>(data_), this->messageSize());
+				septentrio_gnss_driver::GpggaPtr msg;
 				GpggaParser parser_obj;
 				try
 				{
@@ -650,31 +946,15 @@ namespace io_comm_rx
 				{
 					throw std::runtime_error(e.what());
 				}
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::Gpgga>("/gpgga", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gpgga", *msg);
 				break;
 			}
 			case evGPRMC:
 			{
-				boost::char_separator<char> sep("\r");
-				typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
-				std::size_t nmea_size = this->messageSize();
-				std::string block_in_string(reinterpret_cast<const char*>(data_), nmea_size);
-				tokenizer tokens(block_in_string, sep);
-				
-				std::string id = this->messageID();
-				std::string one_message = *tokens.begin();
-				boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens);
-				tokenizer tokens_2(one_message, sep_2);
-				std::vector<std::string> body;
-				for (tokenizer::iterator tok_iter = tokens_2.begin(); tok_iter != tokens_2.end(); ++tok_iter) 
-				{
-					body.push_back(*tok_iter);
-				}
-				// Create NmeaSentence struct to pass to GprmcParser::parseASCII
-				NMEASentence rmc_message(id, body);
-				septentrio_gnss_driver::GprmcPtr msg = boost::make_shared<septentrio_gnss_driver::Gprmc>();
+				// Create NMEASentence to pass to GprmcParser::parseASCII, cf. the evGPGGA case
+				NMEASentence rmc_message(reinterpret_cast<const char*>(data_), this->messageSize());
+				septentrio_gnss_driver::GprmcPtr msg;
 				GprmcParser parser_obj;
 				try
 				{
@@ -684,31 +964,15 @@ namespace io_comm_rx
 				{
 					throw std::runtime_error(e.what());
 				}
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::Gprmc>("/gprmc", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gprmc", *msg);
 				break;
 			}
 			case evGPGSA:
 			{
-				boost::char_separator<char> sep("\r");
-				typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
-				std::size_t nmea_size = this->messageSize();
-				std::string block_in_string(reinterpret_cast<const char*>(data_), nmea_size);
-				tokenizer tokens(block_in_string, sep);
-				
-				std::string id = this->messageID();
-				std::string one_message = *tokens.begin();
-				boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens);
-				tokenizer tokens_2(one_message, sep_2);
-				std::vector<std::string> body;
-				for (tokenizer::iterator tok_iter = tokens_2.begin(); tok_iter != tokens_2.end(); ++tok_iter) 
-				{
-					body.push_back(*tok_iter);
-				}
-				// Create NmeaSentence struct to pass to GpgsaParser::parseASCII
-				NMEASentence gsa_message(id, body);
-				septentrio_gnss_driver::GpgsaPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgsa>();
+				// Create NMEASentence to pass to GpgsaParser::parseASCII, cf. the evGPGGA case
+				NMEASentence gsa_message(reinterpret_cast<const char*>(data_), this->messageSize());
+				septentrio_gnss_driver::GpgsaPtr msg;
 				GpgsaParser parser_obj;
 				try
 				{
@@ -718,36 +982,19 @@ namespace io_comm_rx
 				{
 					throw std::runtime_error(e.what());
 				}
-				uint32_t tow = last_pvtgeodetic_.tow;
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(last_pvtgeodetic_.tow, last_pvtgeodetic_.wnc);
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::Gpgsa>("/gpgsa", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gpgsa", *msg);
 				break;
 			}
 			case evGPGSV: case evGLGSV: case evGAGSV:
 			{
-				boost::char_separator<char> sep("\r");
-				typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
-				std::size_t nmea_size = this->messageSize();
-				std::string block_in_string(reinterpret_cast<const char*>(data_), nmea_size);
-				tokenizer tokens(block_in_string, sep);
-				
-				std::string id = this->messageID();
-				std::string one_message = *tokens.begin();
-				boost::char_separator<char> sep_2(",*", "", boost::keep_empty_tokens);
-				tokenizer tokens_2(one_message, sep_2);
-				std::vector<std::string> body;
-				for (tokenizer::iterator tok_iter = tokens_2.begin(); tok_iter != tokens_2.end(); ++tok_iter)
-				{
-					body.push_back(*tok_iter);
-				}
-				// Create NmeaSentence struct to pass to GpgsvParser::parseASCII
-				NMEASentence gsv_message(id, body);
-				septentrio_gnss_driver::GpgsvPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgsv>();
+				// Create NMEASentence to pass to GpgsvParser::parseASCII, cf. the evGPGGA case
+				NMEASentence gsv_message(reinterpret_cast<const char*>(data_), this->messageSize());
+				septentrio_gnss_driver::GpgsvPtr msg;
 				GpgsvParser parser_obj;
 				try
 				{
@@ -757,19 +1004,17 @@ namespace io_comm_rx
 				{
 					throw std::runtime_error(e.what());
 				}
-				uint32_t tow = last_pvtgeodetic_.tow;
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(last_pvtgeodetic_.tow, last_pvtgeodetic_.wnc);
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				static ros::Publisher publisher = g_nh->advertise<septentrio_gnss_driver::Gpgsv>("/gpgsv", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gpgsv", *msg);
 				break;
 			}
 			case evNavSatFix:
 			{
-				sensor_msgs::NavSatFixPtr msg = boost::make_shared<sensor_msgs::NavSatFix>();
+				sensor_msgs::NavSatFixPtr msg;
 				try
 				{
 					msg = NavSatFixCallback();
@@ -779,21 +1024,17 @@ namespace io_comm_rx
 					throw std::runtime_error(e.what());
 				}
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_pvtgeodetic_has_arrived_navsatfix = false;
-				g_poscovgeodetic_has_arrived_navsatfix = false;
-				static ros::Publisher publisher = g_nh->advertise<sensor_msgs::NavSatFix>("/navsatfix", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/navsatfix", *msg);
 				break;
 			}
 			case evGPSFix:
 			{
-				gps_common::GPSFixPtr msg = boost::make_shared<gps_common::GPSFix>();
+				gps_common::GPSFixPtr msg;
 				try
 				{
 					msg = GPSFixCallback();
@@ -805,30 +1046,20 @@ namespace io_comm_rx
 				msg->status.header.seq = count_gpsfix_;
 				msg->header.frame_id = g_frame_id;
 				msg->status.header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->status.header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
 				msg->status.header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
 				++count_gpsfix_;
-				g_channelstatus_has_arrived_gpsfix = false;
-				g_measepoch_has_arrived_gpsfix = false;
-				g_dop_has_arrived_gpsfix = false;
-				g_pvtgeodetic_has_arrived_gpsfix = false;
-				g_poscovgeodetic_has_arrived_gpsfix = false;
-				g_velcovgeodetic_has_arrived_gpsfix = false;
-				g_atteuler_has_arrived_gpsfix = false;
-				g_attcoveuler_has_arrived_gpsfix = false;
-				static ros::Publisher publisher = g_nh->advertise<gps_common::GPSFix>("/gpsfix", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/gpsfix", *msg);
 				break;
 			}
 			case evPoseWithCovarianceStamped:
 			{
-				geometry_msgs::PoseWithCovarianceStampedPtr msg = boost::make_shared<geometry_msgs::PoseWithCovarianceStamped>();
+				geometry_msgs::PoseWithCovarianceStampedPtr msg;
 				try
 				{
 					msg = PoseWithCovarianceStampedCallback();
@@ -838,47 +1069,63 @@ namespace io_comm_rx
 					throw std::runtime_error(e.what());
 				}
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_pvtgeodetic_has_arrived_pose = false;
-				g_poscovgeodetic_has_arrived_pose = false;
-				g_atteuler_has_arrived_pose = false;
-				g_attcoveuler_has_arrived_pose = false;
-				static ros::Publisher publisher = g_nh->advertise<geometry_msgs::PoseWithCovarianceStamped>("/pose", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/pose", *msg);
 				break;
 			}
 			case evChannelStatus:
 			{
 				memcpy(&last_channelstatus_, data_, sizeof(last_channelstatus_));
-				g_channelstatus_has_arrived_gpsfix = true;
+				if (g_publish_channelstatus)
+				{
+					septentrio_gnss_driver::ChannelStatusPtr msg = ChannelStatusCallback();
+					msg->header.frame_id = g_frame_id;
+					ros::Time time_obj;
+					time_obj = messageStamp(this->getTow(), this->getWnc());
+					msg->header.stamp.sec = time_obj.sec;
+					msg->header.stamp.nsec = time_obj.nsec;
+					msg->block_header.id = 4013;
+					// The handlers of this key are registered publish-only (cf. defineMessages()), hence
+					// no copy-out into the caller's message here
+					PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/channelstatus", *msg);
+				}
 				break;
 			}
 			case evMeasEpoch:
 			{
 				memcpy(&last_measepoch_, data_, sizeof(last_measepoch_));
-				g_measepoch_has_arrived_gpsfix = true;
+				if (g_publish_measepoch)
+				{
+					septentrio_gnss_driver::MeasEpochPtr msg = MeasEpochCallback();
+					msg->header.frame_id = g_frame_id;
+					ros::Time time_obj;
+					time_obj = messageStamp(this->getTow(), this->getWnc());
+					msg->header.stamp.sec = time_obj.sec;
+					msg->header.stamp.nsec = time_obj.nsec;
+					msg->block_header.id = 4027;
+					// The handlers of this key are registered publish-only (cf. defineMessages()), hence
+					// no copy-out into the caller's message here
+					PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/measepoch", *msg);
+				}
 				break;
 			}
 			case evDOP:
 			{
 				memcpy(&last_dop_, data_, sizeof(last_dop_));
-				g_dop_has_arrived_gpsfix = true;
 				break;
 			}
 			case evVelCovGeodetic:
 			{
 				memcpy(&last_velcovgeodetic_, data_, sizeof(last_velcovgeodetic_));
-				g_velcovgeodetic_has_arrived_gpsfix = true;
 				break;
 			}
 			case evDiagnosticArray:
 			{
-				diagnostic_msgs::DiagnosticArrayPtr msg = boost::make_shared<diagnostic_msgs::DiagnosticArray>();
+				diagnostic_msgs::DiagnosticArrayPtr msg;
 				try
 				{
 					msg = DiagnosticArrayCallback();
@@ -888,28 +1135,22 @@ namespace io_comm_rx
 					throw std::runtime_error(e.what());
 				}
 				msg->header.frame_id = g_frame_id;
-				uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
 				ros::Time time_obj;
-				time_obj = timestampSBF(tow, g_use_gnss_time);
+				time_obj = messageStamp(this->getTow(), this->getWnc());
 				msg->header.stamp.sec = time_obj.sec;
 				msg->header.stamp.nsec = time_obj.nsec;
-				memcpy(&message, msg.get(), sizeof(*msg));
-				g_receiverstatus_has_arrived_diagnostics = false;
-				g_qualityind_has_arrived_diagnostics = false;
-				static ros::Publisher publisher = g_nh->advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", g_ROS_QUEUE_SIZE);
-				publisher.publish(*msg);
+				if (!publish_only) memcpy(&message, msg.get(), sizeof(*msg));
+				PublisherRegistry::publish(stream_id_, message_key, topic_prefix_, "/diagnostics", *msg);
 				break;
 			}
 			case evReceiverStatus:
 			{
 				memcpy(&last_receiverstatus_, data_, sizeof(last_receiverstatus_));
-				g_receiverstatus_has_arrived_diagnostics = true;
 				break;
 			}
 			case evQualityInd:
 			{
 				memcpy(&last_qualityind_, data_, sizeof(last_qualityind_));
-				g_qualityind_has_arrived_diagnostics = true;
 				break;
 			}
 			case evReceiverSetup:
@@ -0,0 +1,139 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROS includes
+#include <ros/ros.h>
+
+// C++ library includes
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+/**
+ * @file spsc_ring_buffer.hpp
+ * @brief Declares a lock-free single-producer single-consumer ring buffer for the I/O-thread-to-parser-thread handover
+ * @date 14/01/26
+ */
+
+/**
+ * @class SPSCRingBuffer
+ * @brief Lock-free single-producer single-consumer byte ring buffer
+ *
+ * Exactly one thread (the ASIO I/O thread) may call write() and exactly one thread (the parser thread) may call
+ * read(). Under that contract both sides are wait-free: the producer never blocks on the consumer and vice versa.
+ * The head and tail indices increase monotonically and are reduced modulo the capacity (a power of two) only
+ * when indexing into the backing storage, which makes the full/empty distinction trivial.
+ *
+ * Overflow policy: a full ring means the parser did not keep up, and some bytes must be sacrificed. Dropping
+ * the newest ones (by truncating the incoming chunk) would cut the stream mid-message and leave the parser
+ * feeding on a stale backlog, hence write() instead evicts the !oldest! unread bytes - the ones that would
+ * have been parsed last anyway - by advancing the tail index itself. Since the tail is thereby no longer
+ * advanced by the consumer alone, all tail advances go through a compare-and-swap loop (cf. advanceTailTo());
+ * the consumer learns of the eviction via consumeOverflowFlag() and re-synchronizes, cf. the tryParsing()
+ * method of the AsyncManager class.
+ */
+class SPSCRingBuffer
+{
+	public:
+		//! Constructor of SPSCRingBuffer, rounds the capacity up to the next power of two
+		explicit SPSCRingBuffer(std::size_t capacity);
+		//! Destructor of SPSCRingBuffer
+		~SPSCRingBuffer();
+		//! Returns the number of bytes that have been written but not yet read (safe to call from either thread)
+		std::size_t size() const
+		{
+			return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+		}
+		//! Returns the (rounded-up) capacity of the ring buffer
+		std::size_t capacity() const { return capacity_; }
+		//! Returns whether the ring buffer is currently empty
+		bool empty() const { return size() == 0; }
+		//! Writes all "bytes" bytes, evicting the oldest unread bytes first in case the ring is (partly)
+		//! full, cf. the overflow policy in the class description; returns the number of bytes written
+		std::size_t write(const uint8_t *data, std::size_t bytes);
+		//! Returns number of bytes read
+		std::size_t read(uint8_t *data, std::size_t bytes);
+		//! Returns whether the producer has evicted unread bytes since the last call and clears the flag
+		//! (consumer thread only); a true return obliges the parser to discard any carried-over incomplete
+		//! message, whose remainder was (or is about to be) overwritten, and to hunt for the next sync pair
+		bool consumeOverflowFlag() { return overflowed_.exchange(false, std::memory_order_acquire); }
+		//! Returns the total number of bytes ever written, i.e. the monotonic write index (producer thread only);
+		//! used to key per-burst metadata such as the ingest stamp journal of the AsyncManager class
+		std::size_t totalWritten() const { return head_.load(std::memory_order_relaxed); }
+		//! Returns the total number of bytes ever read, i.e. the monotonic read index (consumer thread only)
+		std::size_t totalRead() const { return tail_.load(std::memory_order_relaxed); }
+
+		// Zero-copy producer interface: async_read_some() can deposit bytes directly into the ring's write
+		// region via writePtr()/contiguousFree() and publish them afterwards via commitWrite(), sparing the
+		// in_ -> ring copy on the I/O thread.
+		//! Returns a pointer to the start of the (contiguous) write region (producer thread only)
+		uint8_t* writePtr() { return data_ + (head_.load(std::memory_order_relaxed) & mask_); }
+		//! Returns the number of free bytes that are contiguous in memory, i.e. do not straddle the wrap point
+		//! (producer thread only)
+		std::size_t contiguousFree() const;
+		//! Publishes "bytes" bytes previously deposited at writePtr() to the consumer (producer thread only)
+		void commitWrite(std::size_t bytes);
+
+		// Zero-copy consumer interface: the parser can decode in place from the ring's read region via
+		// readPtr()/contiguousSize() and release the parsed bytes afterwards via consume(), sparing the
+		// ring -> staging buffer copy for all chunks that do not straddle the wrap point.
+		//! Returns a pointer to the start of the (contiguous) read region (consumer thread only)
+		const uint8_t* readPtr() const { return data_ + (tail_.load(std::memory_order_relaxed) & mask_); }
+		//! Returns the number of readable bytes that are contiguous in memory, i.e. do not straddle the wrap
+		//! point (consumer thread only)
+		std::size_t contiguousSize() const;
+		//! Releases all bytes up to the given monotonic read offset (cf. totalRead()) for reuse by the
+		//! producer (consumer thread only); a no-op in case an overflow eviction has advanced past it already
+		void consumeTo(std::size_t end_offset);
+
+	private:
+		//! Advances the tail index to the given monotonic offset via a compare-and-swap loop, s.t. a
+		//! consumer release and a producer eviction racing on the index merely let the further one win
+		void advanceTailTo(std::size_t target);
+		//! Monotonically increasing write index, only ever advanced by the producer
+		std::atomic<std::size_t> head_;
+		//! Monotonically increasing read index, advanced by the consumer as it releases parsed bytes and -
+		//! solely upon overflow - by the producer as it evicts the oldest unread ones
+		std::atomic<std::size_t> tail_;
+		//! Whether the producer has evicted unread bytes since the consumer last checked, cf. consumeOverflowFlag()
+		std::atomic<bool> overflowed_;
+		//! Capacity of the ring buffer, always a power of two s.t. index masking replaces the modulo operation
+		std::size_t capacity_;
+		//! Bit mask for reducing the monotonic indices to offsets into data_
+		std::size_t mask_;
+		//! Pointer to the backing storage
+		uint8_t * data_;
+};
+
+# endif // for SPSC_RING_BUFFER_HPP
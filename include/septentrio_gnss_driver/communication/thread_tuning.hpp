@@ -0,0 +1,105 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef THREAD_TUNING_HPP
+#define THREAD_TUNING_HPP
+
+// C++ library includes
+#include <cstddef>
+// Boost includes
+#include <boost/thread.hpp>
+
+/**
+ * @file thread_tuning.hpp
+ * @date 01/09/26
+ * @brief Declares a class ThreadTuning applying names, CPU affinity and real-time priority to driver threads
+ */
+
+namespace io_comm_rx
+{
+	/**
+	 * @class ThreadTuning
+	 * @brief Applies the thread_tuning/.. ROS parameters to the driver's I/O and parser threads
+	 *
+	 * On a loaded platform (e.g. an autopilot computer also running vision workloads) the driver's
+	 * threads get preempted like any other, which shows up as tens of milliseconds of ingest stall.
+	 * Configured via configure() (from the thread_tuning/.. ROS parameters, cf. ROSaicNode::getROSParams())
+	 * and applied by the AsyncManager constructor to each of its threads, this class lets the ingest and
+	 * parse path be pinned to (ideally isolated) cores and scheduled under SCHED_FIFO, ahead of every
+	 * fair-share workload.
+	 *
+	 * Irrespective of the parameters, each thread is given a name ("rosaic_io", "rosaic_parse", ..), s.t.
+	 * per-thread CPU time and stalls are attributable in standard tooling (top -H, perf, tracing) instead
+	 * of all threads reporting under the node's name. Everything in here is Linux-specific and compiles to
+	 * no-ops elsewhere.
+	 */
+	class ThreadTuning
+	{
+		public:
+			/**
+			 * @brief Configures the tuning all subsequently spawned driver threads are subjected to
+			 *
+			 * Must be called before the first connection is initialized in order to take effect.
+			 * @param[in] io_cpu CPU the I/O thread(s) are pinned to, -1 leaving them unpinned
+			 * @param[in] parse_cpu CPU the parser thread(s) are pinned to, -1 leaving them unpinned
+			 * @param[in] rt_priority SCHED_FIFO priority (1 to 99) given to the I/O and parser threads,
+			 * 0 leaving them under the default scheduling policy
+			 */
+			static void configure(int io_cpu, int parse_cpu, int rt_priority);
+
+			/**
+			 * @brief Names, pins and prioritizes the given I/O thread
+			 * @param[in] thread The thread running an io_service's run() method
+			 * @param[in] index Index of the thread within the shared I/O thread pool, 0 for a
+			 * stream's dedicated I/O thread
+			 */
+			static void applyIO(boost::thread& thread, std::size_t index = 0);
+
+			/**
+			 * @brief Names, pins and prioritizes the given parser thread
+			 * @param[in] thread The thread running AsyncManager::tryParsing()
+			 */
+			static void applyParser(boost::thread& thread);
+
+		private:
+			//! Names the given thread and applies the given affinity and priority to it, warning (rather
+			//! than failing) in case the OS refuses, e.g. for lack of CAP_SYS_NICE
+			static void apply(boost::thread& thread, const char* name, int cpu, int rt_priority);
+
+			//! CPU the I/O thread(s) are pinned to, -1 (the default) leaving them unpinned
+			static int io_cpu_;
+			//! CPU the parser thread(s) are pinned to, -1 (the default) leaving them unpinned
+			static int parse_cpu_;
+			//! SCHED_FIFO priority of the I/O and parser threads, 0 (the default) meaning default scheduling
+			static int rt_priority_;
+	};
+}
+
+#endif // for THREAD_TUNING_HPP
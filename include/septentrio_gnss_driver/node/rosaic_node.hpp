@@ -71,6 +71,8 @@
 #include <boost/regex.hpp>
 // ROSaic includes
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/decode_worker_pool.hpp>
+#include <septentrio_gnss_driver/communication/thread_tuning.hpp>
 
 extern bool g_publish_gpgga;
 extern bool g_publish_pvtcartesian;
@@ -192,7 +194,16 @@ namespace rosaic_node
 		u.insert(u.begin(), param.begin(), param.end());
 		return true;
 	}
-	
+
+	/**
+	 * @brief Reads the globally scoped parameters (use_gnss_time, frame_id, publish/.., leap_seconds)
+	 * and resets the global handshake state
+	 *
+	 * Factored out of main() s.t. the nodelet entry point (cf. the ROSaicNodelet class) performs the very
+	 * same initialization; must be called after g_nh has been set up and before ROSaicNode is constructed.
+	 */
+	void initializeGlobals();
+
 	/**
 	 * @class ROSaicNode
 	 * @brief This class represents the ROsaic node, to be extended..
@@ -201,8 +212,10 @@ namespace rosaic_node
 	{
 		public:
 		
-			//! The constructor initializes and runs the Rosaic node, if all works out fine.
+			//! The constructor initializes the Rosaic node, if all works out fine.
 			//! It loads the user-defined ROS parameters, subscribes to Rx messages, and publishes requested ROS messages...
+			//! It returns once the receiver is connected and configured; spinning and waiting for shutdown
+			//! is the business of the hosting entry point (main() or the nodelet manager).
 			ROSaicNode();
 			
 			/**
@@ -236,7 +249,30 @@ namespace rosaic_node
 			 * @brief Calles the reconnect() method
 			 */
 			void connect();
-			
+
+			/**
+			 * @brief Called by the reconnect engine of the Comm_IO class once a lost connection to the
+			 * primary receiver has been re-established
+			 *
+			 * The Rx's output streams might point to the stale connection descriptor of the lost TCP session,
+			 * hence the configuration is re-run; with an unchanged receiver, the fingerprint check inside
+			 * configureRx() reduces this to the escape-sequence handshake.
+			 */
+			void handleReconnection();
+
+			/**
+			 * @brief Connects one of the secondary receivers specified via the multi_receiver/secondary_devices
+			 * ROS parameter
+			 *
+			 * In contrast to the primary receiver, secondary receivers are neither configured via configureRx()
+			 * nor retried via the reconnect timer: they are expected to be pre-configured to stream their
+			 * messages, and a failed connection attempt is merely logged, s.t. e.g. an absent corrections link
+			 * never stalls the primary fix.
+			 * @param[in] stream_id The receiver stream of the secondary device, 1 being the first secondary one
+			 * @param[in] device The secondary device's port address, serial port or tcp://host:port alike
+			 */
+			void connectSecondary(std::size_t stream_id, std::string device);
+
 
 			
 		private:
@@ -246,6 +282,10 @@ namespace rosaic_node
 			uint32_t baudrate_;
 			//! HW flow control
 			std::string hw_flow_control_;
+			//! Latency budget in milliseconds the serial reader may spend batching trickling bytes into
+			//! larger reads (0: every byte is ingested as soon as the port offers it), cf. the
+			//! configureSerialBatching() method of the Comm_IO class
+			float serial_max_ingest_latency_ms_;
 			//! In case of serial communication to Rx, rx_serial_port_ specifies Rx's serial port connected to, e.g. USB1 or COM1
 			std::string rx_serial_port_;
 			//! Whether connecting to Rx was successful
@@ -258,6 +298,9 @@ namespace rosaic_node
 			uint32_t polling_period_rest_;
 			//! Delay in seconds between reconnection attempts to the connection type specified in the parameter connection_type
 			float reconnect_delay_s_;
+			//! Ceiling in seconds the reconnect engine's exponentially growing delay between reconnection
+			//! attempts (starting at reconnect_delay_s_ and doubling after every failed attempt) saturates at
+			float reconnect_backoff_max_s_;
 			//! Marker-to-ARP offset in the eastward direction
 			float delta_e_;
 			//! Marker-to-ARP offset in the northward direction
@@ -314,6 +357,9 @@ namespace rosaic_node
 			bool publish_atteuler_;
 			//! Whether or not to publish the septentrio_gnss_driver::AttCovEuler message
 			bool publish_attcoveuler_;
+			//! Comma-separated list of SBF block IDs to be republished verbatim as
+			//! septentrio_gnss_driver::RawBlock messages, with zero decoding; empty disables the passthrough
+			std::string raw_sbf_ids_;
 			//! Since the configureRx() method should only be called once the connection 
 			//! was established, we need the threads to communicate this to each other. Associated mutex..
 			boost::mutex connection_mutex_;
@@ -324,8 +370,62 @@ namespace rosaic_node
 			std::string tcp_host_;
 			//! TCP port number
 			std::string tcp_port_;
+			//! Address of the UDP sender or multicast group to join, may be empty to accept any sender
+			std::string udp_host_;
+			//! Local UDP port the receiver streams to
+			std::string udp_port_;
 			//! Whether yet-to-be-established connection to Rx will be serial or TCP
 			bool serial_;
+			//! Whether device_ points to a (ingest-only) UDP stream (udp:// scheme), unicast or multicast
+			bool udp_;
+			//! Whether device_ points to a logged SBF file (file:// scheme) to be replayed through the
+			//! decode pipeline instead of a live receiver
+			bool sbf_file_playback_;
+			//! Path of the SBF file to be replayed, cf. sbf_file_playback_
+			std::string sbf_file_path_;
+			//! Number of threads of the shared io_service pool all receiver streams are multiplexed over
+			//! (0: one dedicated I/O thread per stream, as before)
+			uint32_t io_thread_pool_size_;
+			//! Number of worker threads the decode + publish stage of the pipeline is spread over
+			//! (0: everything stays on the parser thread, as before), cf. the DecodeWorkerPool class
+			uint32_t decode_threads_;
+			//! Capacity in bytes of the ring buffer decoupling each receiver stream's I/O thread from its
+			//! parser thread, cf. the configureRingBuffer() method of the Comm_IO class
+			uint32_t ring_buffer_size_;
+			//! CPU the I/O thread(s) are pinned to, -1 leaving them unpinned, cf. the ThreadTuning class
+			int io_cpu_affinity_;
+			//! CPU the parser thread(s) are pinned to, -1 leaving them unpinned, cf. the ThreadTuning class
+			int parse_cpu_affinity_;
+			//! SCHED_FIFO priority (1 to 99) given to the I/O and parser threads, 0 leaving them under the
+			//! default scheduling policy, cf. the ThreadTuning class
+			int rt_priority_;
+			//! Comma-separated port addresses (serial ports and tcp://host:port mixed) of secondary receivers
+			//! to be ingested by this very node, e.g. the second antenna of a dual-antenna heading setup or a
+			//! corrections link. Note that the composite ROS messages (NavSatFix, GPSFix, PoseWithCovarianceStamped
+			//! and DiagnosticArray) aggregate SBF blocks in receiver-global state and hence remain meaningful
+			//! for the primary receiver only.
+			std::string secondary_devices_;
+			//! Comma-separated topic prefixes under which the secondary receivers' messages are published;
+			//! secondary receivers beyond the list fall back to /aux1, /aux2 etc.
+			std::string secondary_topic_prefixes_;
+			//! One Comm_IO instance per secondary receiver, cf. secondary_devices_
+			std::vector<boost::shared_ptr<io_comm_rx::Comm_IO>> secondary_IOs_;
+			//! Whether configureRx() streams all commands at once and matches the Rx's responses against an
+			//! outstanding-command queue (one round trip overall), instead of the one-command-at-a-time
+			//! send-then-wait ping-pong (one round trip per command)
+			bool pipelined_configuration_;
+			//! Path of the file the fingerprint of the configuration pushed to the Rx is persisted in, s.t.
+			//! re-sending an unchanged command set (e.g. after a cycled cellular TCP link) is skipped
+			//! entirely; empty (the default) disables the fingerprint check
+			std::string config_fingerprint_path_;
+			//! Whether every received raw byte shall additionally be logged to disk, cf. the RawCapture class
+			bool raw_capture_enabled_;
+			//! The directory the raw capture files are placed in
+			std::string raw_capture_directory_;
+			//! Size in MiB at which the raw capture rotates to the next file of its on-disk ring
+			uint32_t raw_capture_max_file_size_mb_;
+			//! Number of files in the raw capture's on-disk ring
+			uint32_t raw_capture_file_count_;
 	};
 }
 
@@ -0,0 +1,133 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef SBF_FIELD_MAPPING_HPP
+#define SBF_FIELD_MAPPING_HPP
+
+/**
+ * @file sbf_field_mapping.hpp
+ * @date 01/09/26
+ * @brief Compile-time field mappings between the packed SBF structs and their SBF-echoing ROS messages
+ */
+
+/**
+ * @namespace field_mapping
+ * The flat converters of the RxMessage class (PVTGeodeticCallback() and friends) used to copy 20-30
+ * fields by hand, one assignment statement at a time - tedious to audit whenever Septentrio revs a block
+ * layout, and opaque to the compiler. The templates below express each converter as one list of member
+ * pointer pairs instead: the mapping is fully resolved at compile time (no loops, no offsets computed at
+ * runtime), so the compiler sees the same plain member-to-member assignments as before - including the
+ * implicit narrowing/widening each field always underwent - and remains free to fuse adjacent copies.
+ * Adding the converter for a new SBF block boils down to listing its field names once.
+ */
+namespace field_mapping
+{
+	/**
+	 * @class FieldPair
+	 * @brief One field of the mapping: which ROS message member a given packed-struct member lands in
+	 *
+	 * The member types are carried separately for the two sides on purpose, s.t. fields whose ROS
+	 * message type differs from the packed type (the usual implicit conversion on assignment) map just
+	 * as well as identically typed ones.
+	 */
+	template <typename MsgT, typename DataT, typename MsgFieldT, typename DataFieldT>
+	struct FieldPair
+	{
+		//! Pointer to the ROS message member being written
+		MsgFieldT MsgT::* msg_field;
+		//! Pointer to the packed-struct member being read
+		DataFieldT DataT::* data_field;
+	};
+
+	/**
+	 * @brief Builds one FieldPair, deducing all four types from its arguments
+	 * @param[in] msg_field Pointer to the ROS message member being written
+	 * @param[in] data_field Pointer to the packed-struct member being read
+	 * @return The pair, usable as an argument to copyFields()
+	 */
+	template <typename MsgT, typename DataT, typename MsgFieldT, typename DataFieldT>
+	constexpr FieldPair<MsgT, DataT, MsgFieldT, DataFieldT> mapped(MsgFieldT MsgT::* msg_field,
+		DataFieldT DataT::* data_field)
+	{
+		return FieldPair<MsgT, DataT, MsgFieldT, DataFieldT>{msg_field, data_field};
+	}
+
+	/**
+	 * @brief Recursion anchor of the variadic copyFields() below: no fields left, nothing to copy
+	 */
+	template <typename MsgT, typename DataT>
+	inline void copyFields(MsgT&, const DataT&)
+	{
+	}
+
+	/**
+	 * @brief Assigns each listed packed-struct member to its ROS message member, first pair first
+	 *
+	 * The recursion unrolls completely at compile time into the very assignment sequence the
+	 * hand-written converters consisted of.
+	 * @param msg The ROS message being filled in
+	 * @param[in] data The packed struct as memcpy'ed out of the SBF block
+	 * @param[in] first The first member pointer pair, cf. mapped()
+	 * @param[in] rest The remaining member pointer pairs
+	 */
+	template <typename MsgT, typename DataT, typename FirstT, typename... RestT>
+	inline void copyFields(MsgT& msg, const DataT& data, FirstT first, RestT... rest)
+	{
+		msg.*(first.msg_field) = data.*(first.data_field);
+		copyFields(msg, data, rest...);
+	}
+
+	/**
+	 * @brief Fills in the block header sub-message every SBF-echoing ROS message starts with
+	 *
+	 * Every SBF block shares the same 8-byte header followed by the TOW/WNc time stamp pair, and every
+	 * SBF-echoing ROS message mirrors all of that under block_header, hence this part of the mapping
+	 * is spelled out once here rather than once per block.
+	 * @param msg The ROS message being filled in
+	 * @param[in] data The packed struct as memcpy'ed out of the SBF block
+	 */
+	template <typename MsgT, typename DataT>
+	inline void copyBlockHeader(MsgT& msg, const DataT& data)
+	{
+		msg.block_header.sync_1 = data.block_header.sync_1;
+		msg.block_header.sync_2 = data.block_header.sync_2;
+		msg.block_header.crc = data.block_header.crc;
+		msg.block_header.id = data.block_header.id;
+		msg.block_header.length = data.block_header.length;
+		msg.block_header.tow = data.tow;
+		msg.block_header.wnc = data.wnc;
+	}
+}
+
+//! Shorthand for the - overwhelmingly common - case of a field keeping its name across the packed struct
+//! and the ROS message; expects the using converter to typedef the two sides as MsgType and DataType
+#define SBF_MAPPED_FIELD(name) field_mapping::mapped(&MsgType::name, &DataType::name)
+
+#endif // for SBF_FIELD_MAPPING_HPP
@@ -32,32 +32,72 @@
 #define NMEA_SENTENCE_HPP
 
 // C++ library includes
-#include <string>
-#include <vector>
+#include <cstddef>
+// Boost includes
+#include <boost/utility/string_ref.hpp>
 
 /**
  * @file nmea_sentence.hpp
- * @brief Defines a struct NMEASentence, into which NMEA sentences - both standardized and proprietary ones - should be mapped
- * @date 13/08/20 
+ * @brief Defines a class NMEASentence, into which NMEA sentences - both standardized and proprietary ones - should be mapped
+ * @date 13/08/20
  */
- 
+
 
 /**
- * @brief Struct to split an NMEA sentence into its ID and its body, the latter tokenized into a vector of strings.
- * 
- * By ID, we mean either a standardized ID, e.g. "$GPGGA", or proprietary ID such as "$PSSN,HRP".
- * The STL Container Vector can be used to dynamically allocate arrays (C++ feature). Also note that the ID of !all! 
- * (not just those defined by Septentrio) proprietary NMEA messages starts with "$P".
- * The body_ member variable shall exclude the NMEA checksum (also hinted at in files that implement the parsing).
+ * @brief Class that splits an NMEA sentence into its comma-separated fields, all of which remain views into the receive buffer
+ *
+ * By ID, we mean either a standardized ID, e.g. "$GPGGA", or proprietary ID such as "$PSSN,HRP". Also note that the ID of
+ * !all! (not just those defined by Septentrio) proprietary NMEA messages starts with "$P".
+ * The splitting is done in a single pass over the sentence and, since the fields are boost::string_ref views into the
+ * receive buffer held in a fixed-capacity array, involves no heap allocation whatsoever - formerly each sentence cost
+ * two boost::tokenizer passes plus a std::string per field. The views are only valid as long as the receive buffer
+ * underneath is, i.e. for the duration of one read() call of the RxMessage class.
+ * The trailing checksum ends up as the last field (separated by '*' on the wire), though it is never parsed.
  */
 class NMEASentence
 {
 	public:
-		NMEASentence(std::string id, std::vector<std::string> body): id_(id), body_(body) {}
-		std::vector<std::string> get_body() const {return body_;}
-	protected:
-		std::string id_;
-		std::vector<std::string> body_;
+		//! Upper bound on the number of fields; generously covers the longest sentence we parse (GSV with 4 satellites)
+		static const std::size_t MAX_FIELDS = 32;
+
+		/**
+		 * @brief Constructor of the class NMEASentence: splits [data, data + size) at every ',' and '*' in one pass
+		 *
+		 * Splitting stops at the first <CR> or <LF> (or after MAX_FIELDS fields, in which case the length checks
+		 * of the parsers will reject the sentence). Empty fields are kept, mirroring NMEA's ",," convention for
+		 * fields without a value. Field 0 is the sentence ID.
+		 * @param[in] data Pointer to the first byte of the sentence (the leading $)
+		 * @param[in] size Number of bytes up to and including the final <LF>
+		 */
+		NMEASentence(const char* data, std::size_t size): field_count_(0)
+		{
+			std::size_t field_start = 0;
+			std::size_t i;
+			for (i = 0; i < size; ++i)
+			{
+				char c = data[i];
+				if (c == '\r' || c == '\n') break;
+				if (c == ',' || c == '*')
+				{
+					if (field_count_ < MAX_FIELDS) fields_[field_count_++] = boost::string_ref(data + field_start, i - field_start);
+					field_start = i + 1;
+				}
+			}
+			if (field_count_ < MAX_FIELDS) fields_[field_count_++] = boost::string_ref(data + field_start, i - field_start);
+		}
+
+		//! Number of fields the sentence was split into, the ID at index 0 and the checksum included
+		std::size_t size() const {return field_count_;}
+		//! Read access to the individual fields, all of which are views into the receive buffer
+		boost::string_ref operator[](std::size_t index) const {return fields_[index];}
+		//! The sentence ID, e.g. "$GPGGA"
+		boost::string_ref get_id() const {return field_count_ > 0 ? fields_[0] : boost::string_ref();}
+
+	private:
+		//! The fields as views into the receive buffer; a fixed-capacity array s.t. splitting allocates nothing
+		boost::string_ref fields_[MAX_FIELDS];
+		//! Number of entries of fields_ that are in use
+		std::size_t field_count_;
 };
 
 
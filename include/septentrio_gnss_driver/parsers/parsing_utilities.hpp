@@ -36,6 +36,8 @@
 #include <string> // C++ header, corresponds to <string.h> in C
 #include <ctime> // C++ header, corresponds to <time.h> in C
 #include <cmath> // C++ header, corresponds to <math.h> in C
+// Boost includes
+#include <boost/utility/string_ref.hpp> // For the allocation-free overloads taking views into the receive buffer
 // ROS includes
 #include <ros/ros.h>
 #include <geometry_msgs/Quaternion.h>
@@ -66,6 +68,16 @@ namespace parsing_utilities
 	 */
 	bool parseDouble(const std::string& string, double& value);
 
+	/**
+	 * @brief Interprets the contents of "string" as a floating point number of type double
+	 *
+	 * Allocation-free overload for fields of an NMEASentence, which are views into the receive buffer.
+	 * @param[in] string The view whose content should be interpreted as a floating point number
+	 * @param[out] value The double variable that should be overwritten by the floating point number found in "string"
+	 * @return True if all went fine, false if not
+	 */
+	bool parseDouble(boost::string_ref string, double& value);
+
 	/**
 	 * @brief Converts a 4-byte-buffer into a float
 	 * @param[in] buffer A pointer to a buffer containing 4 bytes of data
@@ -83,6 +95,16 @@ namespace parsing_utilities
 	 */
 	bool parseFloat(const std::string& string, float& value);
 
+	/**
+	 * @brief Interprets the contents of "string" as a floating point number of type float
+	 *
+	 * Allocation-free overload for fields of an NMEASentence, which are views into the receive buffer.
+	 * @param[in] string The view whose content should be interpreted as a floating point number
+	 * @param[out] value The float variable that should be overwritten by the floating point number found in "string"
+	 * @return True if all went fine, false if not
+	 */
+	bool parseFloat(boost::string_ref string, float& value);
+
 	/**
 	 * @brief Converts a 2-byte-buffer into a signed 16-bit integer
 	 * @param[in] buffer A pointer to a buffer containing 2 bytes of data
@@ -130,6 +152,17 @@ namespace parsing_utilities
 	 */
 	bool parseUInt8(const std::string& string, uint8_t& value, int32_t base = 10);
 
+	/**
+	 * @brief Interprets the contents of "string" as a unsigned integer number of type uint8_t.
+	 *
+	 * Allocation-free overload for fields of an NMEASentence, which are views into the receive buffer.
+	 * @param[in] string The view whose content should be interpreted as an integer number
+	 * @param[out] value The uint8_t variable that should be overwritten by the integer number found in "string"
+	 * @param[in] base The numerical base of the integer in the string, default being 10
+	 * @return True if all went fine, false if not
+	 */
+	bool parseUInt8(boost::string_ref string, uint8_t& value, int32_t base = 10);
+
 	/**
 	 * @brief Converts a 2-byte-buffer into an unsigned 16-bit integer
 	 * @param[in] buffer A pointer to a buffer containing 2 bytes of data
@@ -166,6 +199,17 @@ namespace parsing_utilities
 	 */
 	bool parseUInt32(const std::string& string, uint32_t& value, int32_t base = 10);
 
+	/**
+	 * @brief Interprets the contents of "string" as a unsigned integer number of type uint32_t.
+	 *
+	 * Allocation-free overload for fields of an NMEASentence, which are views into the receive buffer.
+	 * @param[in] string The view whose content should be interpreted as an integer number
+	 * @param[out] value The uint32_t variable that should be overwritten by the integer number found in "string"
+	 * @param[in] base The numerical base of the integer in the string, default being 10
+	 * @return True if all went fine, false if not
+	 */
+	bool parseUInt32(boost::string_ref string, uint32_t& value, int32_t base = 10);
+
 	/**
 	 * @brief Converts UTC time from the without-colon-delimiter format to the number-of-seconds-since-midnight format
 	 * @param[in] utc_double Rrepresents UTC time in the without-colon-delimiter format
@@ -190,7 +234,21 @@ namespace parsing_utilities
 	 * @return Represents latitude or longitude in the pure degree notation
 	 */
 	double convertDMSToDegrees(double dms);
-	
+
+	/**
+	 * @brief Parses a latitude or longitude field given in NMEA's fixed ddmm.mmmm (respectively dddmm.mmmm) format directly into the pure degree notation
+	 *
+	 * Specialized replacement for the parseDouble-then-convertDMSToDegrees combination on the latitude and longitude
+	 * fields: Being fixed-format, those can be converted with pure integer arithmetic, skipping the generic floating
+	 * point machinery that otherwise dominates the NMEA parse time. An empty field yields 0 degrees and true, in line
+	 * with the parseDouble behavior on empty fields.
+	 * @param[in] dms Represents latitude or longitude in the DMS notation (in the without-colon-delimiter format)
+	 * @param[out] degrees The double variable that should be overwritten with the latitude or longitude in the pure degree notation
+	 * @return True if all went fine, false if not
+	 */
+	bool parseDMSDegrees(boost::string_ref dms, double& degrees);
+
+
 	/**
 	 * @brief Transforms Euler angles to a quaternion
 	 * @param[in] yaw Yaw, i.e. heading, about the Up-axis
@@ -36,6 +36,8 @@
 #include <stdint.h>
 #include <string>
 #include <locale> // Merely for "isdigit()" function, also available in <cctype.h> C header..
+// Boost includes
+#include <boost/utility/string_ref.hpp> // Non-owning views into the receive buffer, avoids copying fields
  
 /**
  * @file string_utilities.h
@@ -60,7 +62,7 @@ namespace string_utilities
 	 * @param[out] value The double variable that should be overwritten by the floating point number found in "string"
 	 * @return True if all went fine, false if not
 	 */
-	bool toDouble(const std::string& string, double& value);
+	bool toDouble(boost::string_ref string, double& value);
 	
 	/**
 	 * @brief Interprets the contents of "string" as a floating point number of type float.
@@ -70,7 +72,7 @@ namespace string_utilities
 	 * @param[out] value The float variable that should be overwritten by the floating point number found in "string"
 	 * @return True if all went fine, false if not
 	 */ 
-	bool toFloat(const std::string& string, float& value);
+	bool toFloat(boost::string_ref string, float& value);
  
 	/**
 	 * @brief Interprets the contents of "string" as a floating point number of whatever integer type your system has that is exactly 32 bits.
@@ -80,7 +82,7 @@ namespace string_utilities
 	 * @param[out] value The int32_t variable that should be overwritten by the floating point number found in "string"
 	 * @return True if all went fine, false if not
 	 */ 
-	bool toInt32(const std::string& string, int32_t& value, int32_t base = 10);
+	bool toInt32(boost::string_ref string, int32_t& value, int32_t base = 10);
  
 	/**
 	 * @brief Interprets the contents of "string" as a floating point number of whatever unsigned integer type your system has that is exactly 32 bits.
@@ -90,7 +92,7 @@ namespace string_utilities
 	 * @param[out] value The uint32_t variable that should be overwritten by the floating point number found in "string"
 	 * @return True if all went fine, false if not
 	 */ 
-	bool toUInt32(const std::string& string, uint32_t& value, int32_t base = 10);
+	bool toUInt32(boost::string_ref string, uint32_t& value, int32_t base = 10);
 	
 	/**
 	 * @brief Interprets the contents of "string" as a floating point number of whatever integer type your system has that is exactly 8 bits.
@@ -29,6 +29,9 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/communication/callback_handlers.hpp>
+#include <septentrio_gnss_driver/communication/decode_worker_pool.hpp>
+// Boost includes
+#include <boost/chrono.hpp>
 
 /**
  * @file callback_handlers.cpp
@@ -36,303 +39,349 @@
  * @brief Handles callbacks when reading NMEA/SBF messages
  */
  
-std::pair<std::string, uint32_t> gpsfix_pairs[] =
+namespace io_comm_rx
 {
-	std::make_pair("4013", 0),
-	std::make_pair("4027", 1),
-	std::make_pair("4001", 2),
-	std::make_pair("4007", 3),
-	std::make_pair("5906", 4),
-	std::make_pair("5908", 5),
-	std::make_pair("5938", 6),
-	std::make_pair("5939", 7)
-};
+	boost::mutex CallbackHandlers::callback_mutex_;
 
-std::pair<std::string, uint32_t> navsatfix_pairs[] =
-{
-	std::make_pair("4007", 0),
-	std::make_pair("5906", 1)
-};
+	boost::mutex CallbackHandlers::decode_state_mutex_;
 
+	std::vector<CallbackHandlers::HandlerList> CallbackHandlers::dispatch_table_;
+	std::vector<boost::shared_ptr<AbstractCallbackHandler>> CallbackHandlers::raw_dispatch_table_;
 
-std::pair<std::string, uint32_t> pose_pairs[] =
-{
-	std::make_pair("4007", 0),
-	std::make_pair("5906", 1),
-	std::make_pair("5938", 2),
-	std::make_pair("5939", 3)
-};
+	CallbackHandlers::DecodeProfiler CallbackHandlers::decode_profiler_ = NULL;
 
-std::pair<std::string, uint32_t> diagnosticarray_pairs[] =
-{
-	std::make_pair("4014", 0),
-	std::make_pair("4082", 1)
-};
+	void CallbackHandlers::setDecodeProfiler(DecodeProfiler profiler)
+	{
+		decode_profiler_ = profiler;
+	}
 
-namespace io_comm_rx
-{
-	boost::mutex CallbackHandlers::callback_mutex_;
-	
-	CallbackHandlers::GPSFixMap CallbackHandlers::gpsfix_map(gpsfix_pairs, gpsfix_pairs + 8);
-	CallbackHandlers::NavSatFixMap CallbackHandlers::navsatfix_map(navsatfix_pairs, navsatfix_pairs + 2);
-	CallbackHandlers::PoseWithCovarianceStampedMap 
-		CallbackHandlers::pose_map(pose_pairs, pose_pairs + 4);
-	CallbackHandlers::DiagnosticArrayMap 
-		CallbackHandlers::diagnosticarray_map(diagnosticarray_pairs, diagnosticarray_pairs + 2);
-	
-	std::string CallbackHandlers::do_gpsfix_ = "4007";
-	std::string CallbackHandlers::do_navsatfix_ = "4007";
-	std::string CallbackHandlers::do_pose_ = "4007";
-	std::string CallbackHandlers::do_diagnostics_ = "4014";
+	void CallbackHandlers::rebuildDispatchTable(const CallbackMap& callbackmap)
+	{
+		dispatch_table_.assign(RX_ID_TABLE_SIZE, HandlerList());
+		for (CallbackMap::const_iterator callback = callbackmap.begin(); callback != callbackmap.end(); ++callback)
+		{
+			dispatch_table_[callback->first].push_back(callback->second);
+		}
+	}
+
+	//! The bit each constituent block occupies in a collator's arrival bitmask is simply its position in
+	//! the respective switch below; the complete masks handed to the collator constructors cover all of them.
+	uint32_t CallbackHandlers::gpsfixBit(RxIDType message_key)
+	{
+		switch (message_key)
+		{
+			case 4013: return 1;      // ChannelStatus
+			case 4027: return 1 << 1; // MeasEpoch
+			case 4001: return 1 << 2; // DOP
+			case 4007: return 1 << 3; // PVTGeodetic
+			case 5906: return 1 << 4; // PosCovGeodetic
+			case 5908: return 1 << 5; // VelCovGeodetic
+			case 5938: return 1 << 6; // AttEuler
+			case 5939: return 1 << 7; // AttCovEuler
+			default: return 0;
+		}
+	}
 
-	//! The for loop forwards to a ROS message specific handle if the latter was added 
+	uint32_t CallbackHandlers::navsatfixBit(RxIDType message_key)
+	{
+		switch (message_key)
+		{
+			case 4007: return 1;      // PVTGeodetic
+			case 5906: return 1 << 1; // PosCovGeodetic
+			default: return 0;
+		}
+	}
+
+	uint32_t CallbackHandlers::poseBit(RxIDType message_key)
+	{
+		switch (message_key)
+		{
+			case 4007: return 1;      // PVTGeodetic
+			case 5906: return 1 << 1; // PosCovGeodetic
+			case 5938: return 1 << 2; // AttEuler
+			case 5939: return 1 << 3; // AttCovEuler
+			default: return 0;
+		}
+	}
+
+	uint32_t CallbackHandlers::diagnosticarrayBit(RxIDType message_key)
+	{
+		switch (message_key)
+		{
+			case 4014: return 1;      // ReceiverStatus
+			case 4082: return 1 << 1; // QualityInd
+			default: return 0;
+		}
+	}
+
+	EpochCollator CallbackHandlers::gpsfix_collator_((1 << 8) - 1);
+	EpochCollator CallbackHandlers::navsatfix_collator_((1 << 2) - 1);
+	EpochCollator CallbackHandlers::pose_collator_((1 << 4) - 1);
+	EpochCollator CallbackHandlers::diagnosticarray_collator_((1 << 2) - 1);
+
+	RxIDType CallbackHandlers::do_gpsfix_ = RX_ID_UNKNOWN;
+	RxIDType CallbackHandlers::do_navsatfix_ = RX_ID_UNKNOWN;
+	RxIDType CallbackHandlers::do_pose_ = RX_ID_UNKNOWN;
+	RxIDType CallbackHandlers::do_diagnostics_ = RX_ID_UNKNOWN;
+
+	//! The for loop inside dispatch() forwards to a ROS message specific handle if the latter was added
 	//! via callbackmap_.insert at some earlier point.
-	void CallbackHandlers::handle(RxMessage& rx_message)
+	void CallbackHandlers::dispatch(RxMessage& rx_message, CallbackMap::key_type key)
 	{
-		// Find the ROS message callback handler for the equivalent Rx message (SBF/NMEA) at hand & call it
-		boost::mutex::scoped_lock lock(callback_mutex_);
-		CallbackMap::key_type key = rx_message.messageID();
-		std::string ID_temp = rx_message.messageID();
-		if (!(ID_temp == "4013" || ID_temp == "4027" || ID_temp == "4001"|| ID_temp == "5908" || 
-			ID_temp == "4014" || ID_temp == "4082" || ID_temp == "5902")) 
-		// We only want to handle ChannelStatus, MeasEpoch, DOP, VelCovGeodetic, ReceiverStatus, 
-		// QualityInd and ReceiverSetup blocks in case GPSFix and DiagnosticArray messages are to 
-		// be published, respectively, see few lines below.
+		// Find the ROS message callback handler(s) for the equivalent Rx message (SBF/NMEA) at hand & call
+		// them. The lock merely pins the dispatch table during lookup, cf. the declaration of this method.
+		HandlerList handlers;
 		{
-			for (CallbackMap::iterator callback = callbackmap_.lower_bound(key); callback != 
-				callbackmap_.upper_bound(key); ++callback)
+			boost::mutex::scoped_lock lock(callback_mutex_);
+			// The table is only allocated once the first handler is inserted; if none ever was (all
+			// publishing switched off), there is nothing to dispatch to.
+			if (dispatch_table_.empty()) return;
+			handlers = dispatch_table_[key];
+		}
+		for (HandlerList::const_iterator callback = handlers.begin(); callback != handlers.end(); ++callback)
+		{
+			try
 			{
-				try
-				{
-					callback->second->handle(rx_message, callback->first);
-				}
-				catch (std::runtime_error& e) 
-				{
-					throw std::runtime_error(e.what());
-				}
+				(*callback)->handle(rx_message, key);
+			}
+			catch (std::runtime_error& e)
+			{
+				throw std::runtime_error(e.what());
 			}
 		}
+	}
+
+	void CallbackHandlers::dispatchRaw(RxMessage& rx_message, CallbackMap::key_type key)
+	{
+		boost::shared_ptr<AbstractCallbackHandler> handler;
+		{
+			boost::mutex::scoped_lock lock(callback_mutex_);
+			// The table is only allocated once the first raw passthrough is registered; with the
+			// publish/raw_sbf_ids parameter left empty (the default), this is one early return.
+			if (raw_dispatch_table_.empty()) return;
+			handler = raw_dispatch_table_[key];
+		}
+		if (handler)
+		{
+			handler->handle(rx_message, key);
+		}
+	}
+
+	void CallbackHandlers::handle(RxMessage& rx_message)
+	{
+		// The numeric ID serves as multimap key and in all comparisons below; determining it once up front
+		// suffices since it cannot change while the present message is being handled.
+		RxIDType ID_temp = rx_message.messageNumber();
+		// The raw passthrough comes first and unconditionally: a block ID listed in publish/raw_sbf_ids
+		// must reach the /rawblock topic irrespective of the decode-flag gating below - listing e.g.
+		// MeasEpoch precisely to skip its decode is the passthrough's headline use case, and the gating
+		// would otherwise swallow exactly those blocks.
+		dispatchRaw(rx_message, ID_temp);
+		if (!(ID_temp == 4013 || ID_temp == 4027 || ID_temp == 4001 || ID_temp == 5908 ||
+			ID_temp == 4014 || ID_temp == 4082 || ID_temp == 5902))
+		// We only want to handle ChannelStatus, MeasEpoch, DOP, VelCovGeodetic, ReceiverStatus, 
+		// QualityInd and ReceiverSetup blocks in case GPSFix and DiagnosticArray messages (or the 
+		// full MeasEpoch/ChannelStatus decodes) are to be published, respectively, see few lines below.
+		{
+			dispatch(rx_message, ID_temp);
+		}
 		// Call NavSatFix callback function if it was added
 		if (g_publish_navsatfix)
 		{
-			CallbackMap::key_type key = "NavSatFix";
-			std::string ID_temp = rx_message.messageID();
-			if (ID_temp == do_navsatfix_) 
+			if (ID_temp == do_navsatfix_)
 			// The last incoming block among PVTGeodetic and PosCovGeodetic triggers the publishing of NavSatFix. 
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key); callback != 
-					callbackmap_.upper_bound(key); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
-				do_navsatfix_ = std::string();
+				dispatch(rx_message, RX_ID_NAVSATFIX);
+				do_navsatfix_ = RX_ID_UNKNOWN;
 			}
 		}
 		// Call geometry_msgs::PoseWithCovarianceStamped callback function if it was added
 		if (g_publish_pose)
 		{
-			CallbackMap::key_type key = "PoseWithCovarianceStamped";
-			std::string ID_temp = rx_message.messageID();
-			if (ID_temp == do_pose_) 
+			if (ID_temp == do_pose_)
 			// The last incoming block among PVTGeodetic, PosCovGeodetic, AttEuler and AttCovEuler triggers 
 			// the publishing of PoseWithCovarianceStamped. 
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key); callback != 
-					callbackmap_.upper_bound(key); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
-				do_pose_ = std::string();
+				dispatch(rx_message, RX_ID_POSEWITHCOVARIANCESTAMPED);
+				do_pose_ = RX_ID_UNKNOWN;
 			}
 		}
 		// Call diagnostic_msgs::DiagnosticArray callback function if it was added
 		if (g_publish_diagnostics)
 		{
-			CallbackMap::key_type key1 = rx_message.messageID();
-			std::string ID_temp = rx_message.messageID();
-			if (ID_temp == "4014" || ID_temp == "4082" || ID_temp == "5902")
+			if (ID_temp == 4014 || ID_temp == 4082 || ID_temp == 5902)
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key1); callback != 
-					callbackmap_.upper_bound(key1); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
+				dispatch(rx_message, ID_temp);
 			}
-			CallbackMap::key_type key2 = "DiagnosticArray";
-			if (ID_temp == do_diagnostics_) 
+			if (ID_temp == do_diagnostics_)
 			// The last incoming block among ReceiverStatus, QualityInd and ReceiverSetup triggers 
 			// the publishing of DiagnosticArray. 
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key2); callback != 
-					callbackmap_.upper_bound(key2); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
-				do_diagnostics_ = std::string();
+				dispatch(rx_message, RX_ID_DIAGNOSTICARRAY);
+				do_diagnostics_ = RX_ID_UNKNOWN;
 			}
 		}
 		// Call sensor_msgs::TimeReference (with GPST) callback function if it was added
 		if (g_publish_gpst)
 		{
-			CallbackMap::key_type key1 = "GPST";
-			std::string ID_temp = rx_message.messageID();
-			// If no new PVTGeodetic block is coming in, there is no need to publish sensor_msgs::TimeReference (with GPST) anew. 
-			if (ID_temp == "4007")
+			// If no new PVTGeodetic block is coming in, there is no need to publish sensor_msgs::TimeReference (with GPST) anew.
+			if (ID_temp == 4007)
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key1); callback != 
-					callbackmap_.upper_bound(key1); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
+				dispatch(rx_message, RX_ID_GPST);
+			}
+		}
+		// Dispatch the full MeasEpoch/ChannelStatus decodes in case they were asked for while GPSFix is
+		// switched off; with GPSFix switched on, the dispatching right below covers these blocks anyway.
+		if (!g_publish_gpsfix)
+		{
+			if ((g_publish_measepoch && ID_temp == 4027) || (g_publish_channelstatus && ID_temp == 4013))
+			{
+				dispatch(rx_message, ID_temp);
 			}
 		}
 		// Call GPSFix callback function if it was added
 		if (g_publish_gpsfix)
 		{
-			std::string ID_temp = rx_message.messageID();
-			CallbackMap::key_type key1 = rx_message.messageID();
-			if (ID_temp == "4013" || ID_temp == "4027" || ID_temp == "4001" || ID_temp == "5908") 
+			if (ID_temp == 4013 || ID_temp == 4027 || ID_temp == 4001 || ID_temp == 5908)
 			// Even though we are not interested in publishing ChannelStatus (4013), MeasEpoch (4027), DOP (4001) 
 			// and VelCovGeodetic (5908) ROS messages, we have to save some contents of these incoming blocks 
 			// in order to publish the GPSFix message.
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key1); callback != 
-					callbackmap_.upper_bound(key1); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
+				dispatch(rx_message, ID_temp);
 			}
-			CallbackMap::key_type key2 = "GPSFix";
 			if (ID_temp == do_gpsfix_)
 			// The last incoming block among ChannelStatus (4013), MeasEpoch (4027), DOP (4001) and 
 			// VelCovGeodetic (5908) triggers the publishing of GPSFix. 
 			{
-				for (CallbackMap::iterator callback = callbackmap_.lower_bound(key2); callback != 
-					callbackmap_.upper_bound(key2); ++callback)
-				{
-					try
-					{
-						callback->second->handle(rx_message, callback->first);
-					}
-					catch (std::runtime_error& e) 
-					{
-						throw std::runtime_error(e.what());
-					}
-				}
-				do_gpsfix_ = std::string();
+				dispatch(rx_message, RX_ID_GPSFIX);
+				do_gpsfix_ = RX_ID_UNKNOWN;
 			}
 		}
 	}
 
-	void CallbackHandlers::readCallback(const uint8_t* data, std::size_t& size) 
+	bool CallbackHandlers::isCompositeConstituent(RxIDType message_key)
+	{
+		switch (message_key)
+		{
+			// ChannelStatus, MeasEpoch, DOP, PVTGeodetic, PosCovGeodetic, VelCovGeodetic, AttEuler,
+			// AttCovEuler, ReceiverStatus, QualityInd and ReceiverSetup all contribute to at least one
+			// composite ROS message
+			case 4013: case 4027: case 4001: case 4007: case 5906: case 5908: case 5938: case 5939:
+			case 4014: case 4082: case 5902:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	//! The composite ROS messages (GPSFix, NavSatFix, PoseWithCovarianceStamped, DiagnosticArray)
+	//! are collated strictly per epoch: each constituent block reports the TOW/WNc pair of its
+	//! time stamp field to the respective collator, and only the block completing its epoch's
+	//! set triggers the publishing - via the same do_.. mechanism the handle() method always
+	//! consulted. A constituent that was lost (e.g. to a CRC failure) hence delays its composite
+	//! message by one epoch instead of silently mixing blocks of different epochs into one.
+	//! Note that for each block type the Rx emits its blocks in chronological order, s.t. the
+	//! last_.. copies the RxMessage class assembles the composite message from are exactly the
+	//! completed epoch's blocks. With decode workers enabled this additionally relies on all
+	//! constituent blocks being pinned to one and the same worker, cf. DecodeWorkerPool::enqueue().
+	void CallbackHandlers::collate(RxMessage& rx_message)
 	{
-		RxMessage rx_message(data, size);
+		RxIDType ID_temp = rx_message.messageNumber();
+		uint32_t tow = rx_message.getTow();
+		uint16_t wnc = rx_message.getWnc();
+		if (g_publish_gpsfix == true && (ID_temp == 4013 || ID_temp == 4027 ||
+			ID_temp == 4001 || ID_temp == 4007 || ID_temp == 5906 || ID_temp == 5908 ||
+			ID_temp == 5938 || ID_temp == 5939))
+		{
+			if (gpsfix_collator_.collate(gpsfixBit(ID_temp), tow, wnc))
+			{
+				do_gpsfix_ = ID_temp;
+			}
+		}
+		if (g_publish_navsatfix == true && (ID_temp == 4007 || ID_temp == 5906))
+		{
+			if (navsatfix_collator_.collate(navsatfixBit(ID_temp), tow, wnc))
+			{
+				do_navsatfix_ = ID_temp;
+			}
+		}
+		if (g_publish_pose == true && (ID_temp == 4007 || ID_temp == 5906 ||
+			ID_temp == 5938 || ID_temp == 5939))
+		{
+			if (pose_collator_.collate(poseBit(ID_temp), tow, wnc))
+			{
+				do_pose_ = ID_temp;
+			}
+		}
+		if (g_publish_diagnostics == true && (ID_temp == 4014 || ID_temp == 4082))
+		{
+			if (diagnosticarray_collator_.collate(diagnosticarrayBit(ID_temp), tow, wnc))
+			{
+				do_diagnostics_ = ID_temp;
+			}
+		}
+	}
+
+	void CallbackHandlers::collateAndHandle(RxMessage& rx_message)
+	{
+		if (rx_message.isSBF() && isCompositeConstituent(rx_message.messageNumber()))
+		{
+			// Constituents of the composite ROS messages all pin to one and the same decode worker (cf.
+			// DecodeWorkerPool::enqueue()), s.t. they collate and decode strictly in arrival order: by the
+			// time the block completing an epoch collates, every other constituent of that epoch has
+			// already been decoded into its last_.. copy, and no block of the next epoch has. The lock
+			// additionally keeps each collate + decode atomic, e.g. against a second receiver stream
+			// whose constituent blocks funnel into the very same (receiver-global) state.
+			boost::mutex::scoped_lock lock(decode_state_mutex_);
+			collate(rx_message);
+			handle(rx_message);
+		}
+		else
+		{
+			handle(rx_message);
+		}
+	}
+
+	void CallbackHandlers::handleFrame(const uint8_t* frame, std::size_t size, const ros::Time& ingest_stamp)
+	{
+		RxMessage rx_message(frame, size, stream_id_, topic_prefix_);
+		rx_message.setIngestStamp(ingest_stamp);
+		// Re-frames the single message the copied-out buffer holds; cannot fail since readCallback() only
+		// enqueues complete frames
+		if (rx_message.search() == rx_message.getEndBuffer() || !rx_message.found()) return;
+		collateAndHandle(rx_message);
+	}
+
+	void CallbackHandlers::readCallback(const uint8_t* data, std::size_t& size,
+		const ros::Time& ingest_stamp) 
+	{
+		RxMessage rx_message(data, size, stream_id_, topic_prefix_);
+		rx_message.setIngestStamp(ingest_stamp);
+		PipelineStats::markChunkStart();
+		DecodeWorkerPool* decode_pool = DecodeWorkerPool::instance();
 		// Read !all! (there might be many) messages in the buffer
-		while (rx_message.search() != rx_message.getEndBuffer() && rx_message.found()) 
+		while (rx_message.search() != rx_message.getEndBuffer() && rx_message.found())
 		{
+			PipelineStats::markSearchHit();
 			// Print the found message (if NMEA) or just show messageID (if SBF)..
 			if (rx_message.isSBF())
 			{
 				std::size_t sbf_block_length;
-				std::string ID_temp = rx_message.messageID();
-				sbf_block_length = static_cast<std::size_t>(rx_message.getBlockLength()); 
-				ROS_DEBUG("ROSaic reading SBF block %s made up of %li bytes...", ID_temp.c_str(), sbf_block_length); 
+				RxIDType ID_temp = rx_message.messageNumber();
+				sbf_block_length = static_cast<std::size_t>(rx_message.getBlockLength());
+				ROS_DEBUG("ROSaic reading SBF block %u made up of %li bytes...", static_cast<unsigned int>(ID_temp), sbf_block_length);
 				// If full message did not yet arrive, throw an error message.
 				if (sbf_block_length > rx_message.getCount())
 				{
 					ROS_DEBUG("Not a valid SBF block, parts of the SBF block are yet to be received. Ignore..");
 					throw (static_cast<std::size_t>(rx_message.getPosBuffer() - data));
 				}
-				if (g_publish_gpsfix == true && (ID_temp == "4013" || ID_temp == "4027" ||
-					ID_temp == "4001" || ID_temp == "4007" || ID_temp == "5906" || ID_temp == "5908" || 
-					ID_temp == "5938" || ID_temp == "5939"))
-				{
-					std::vector<bool> gpsfix_vec = {g_channelstatus_has_arrived_gpsfix, g_measepoch_has_arrived_gpsfix, 
-						g_dop_has_arrived_gpsfix, g_pvtgeodetic_has_arrived_gpsfix, g_poscovgeodetic_has_arrived_gpsfix, 
-						g_velcovgeodetic_has_arrived_gpsfix, g_atteuler_has_arrived_gpsfix, 
-						g_attcoveuler_has_arrived_gpsfix};
-					gpsfix_vec.erase(gpsfix_vec.begin() + gpsfix_map[ID_temp]);
-					// Checks whether all entries in gpsfix_vec are true
-					if (std::all_of(gpsfix_vec.begin(), gpsfix_vec.end(), [](bool v) { return v; }) == true)
-					{
-						do_gpsfix_ = ID_temp;
-					}
-				}
-				if (g_publish_navsatfix == true && (ID_temp == "4007" || ID_temp == "5906"))
-				{
-					std::vector<bool> navsatfix_vec = {g_pvtgeodetic_has_arrived_navsatfix, 
-						g_poscovgeodetic_has_arrived_navsatfix };
-					navsatfix_vec.erase(navsatfix_vec.begin() + navsatfix_map[ID_temp]);
-					// Checks whether all entries in navsatfix_vec are true
-					if (std::all_of(navsatfix_vec.begin(), navsatfix_vec.end(), [](bool v) { return v; }) == true)
-					{
-						do_navsatfix_ = ID_temp;
-					}
-				}
-				if (g_publish_pose == true && (ID_temp == "4007" || ID_temp == "5906" || 
-					ID_temp == "5938" || ID_temp == "5939"))
-				{
-					std::vector<bool> pose_vec = {g_pvtgeodetic_has_arrived_pose, g_poscovgeodetic_has_arrived_pose, 
-						g_atteuler_has_arrived_pose, g_attcoveuler_has_arrived_pose};
-					pose_vec.erase(pose_vec.begin() + pose_map[ID_temp]);
-					// Checks whether all entries in pose_vec are true
-					if (std::all_of(pose_vec.begin(), pose_vec.end(), [](bool v) { return v; }) == true)
-					{
-						do_pose_ = ID_temp;
-					}
-				}
-				if (g_publish_diagnostics == true && (ID_temp == "4014" || ID_temp == "4082"))
+				if (decode_pool != NULL && !rx_message.checkCrc())
 				{
-					std::vector<bool> diagnostics_vec = {g_receiverstatus_has_arrived_diagnostics, 
-						g_qualityind_has_arrived_diagnostics};
-					diagnostics_vec.erase(diagnostics_vec.begin() + diagnosticarray_map[ID_temp]);
-					// Checks whether all entries in diagnostics_vec are true
-					if (std::all_of(diagnostics_vec.begin(), diagnostics_vec.end(), [](bool v) { return v; }) == true)
-					{
-						do_diagnostics_ = ID_temp;
-					}
+					// A corrupted block is not worth copying out to a worker. With crc_check_ false, next()
+					// cannot trust the block's announced length and hunts for the next sync pair byte-wise,
+					// cf. the resync counter of the PipelineStats class.
+					continue;
 				}
 			}
 			if (rx_message.isNMEA())
@@ -355,13 +404,24 @@ namespace io_comm_rx
 				std::size_t response_size = rx_message.messageSize();
 				std::string block_in_string(reinterpret_cast<const char*>(rx_message.getPosBuffer()), response_size);
 				ROS_DEBUG("The Rx's response contains %li bytes and reads:\n %s", response_size, block_in_string.c_str());
+				bool error_response = rx_message.isErrorMessage();
 				{
 					boost::mutex::scoped_lock lock(g_response_mutex);
 					g_response_received = true;
+					// The Rx processes its command line strictly in order and answers each command with its
+					// own "$R" line, hence counting the responses and popping the outstanding-command queue
+					// purely by position suffices to match them, cf. configureRx() in pipelined mode. The
+					// queue is empty outside a pipelined configuration phase.
+					++g_response_count;
+					if (!g_outstanding_commands.empty())
+					{
+						if (error_response) g_response_error = g_outstanding_commands.front();
+						g_outstanding_commands.pop_front();
+					}
 					lock.unlock();
 					g_response_condition.notify_one();
 				}
-				if (rx_message.isErrorMessage())
+				if (error_response)
 				{
 					ROS_ERROR("Invalid command just sent to the Rx!");
 				}
@@ -385,7 +445,27 @@ namespace io_comm_rx
 			//ROS_DEBUG("Handing over from readcallback to handle while count is %li", rx_message.getCount());
 			try
 			{
-				handle(rx_message);
+				if (decode_pool != NULL)
+				{
+					// The parser thread is done with this frame: framing and (for SBF) the CRC held, the
+					// expensive decode + publish remainder happens on the frame's worker, cf. the
+					// DecodeWorkerPool class
+					std::size_t frame_size = rx_message.isSBF() ?
+						static_cast<std::size_t>(rx_message.getBlockLength()) : rx_message.messageSize();
+					decode_pool->enqueue(this, rx_message.messageNumber(), rx_message.getPosBuffer(), frame_size,
+						ingest_stamp);
+				}
+				else if (decode_profiler_ == NULL)
+				{
+					collateAndHandle(rx_message);
+				}
+				else
+				{
+					boost::chrono::steady_clock::time_point handle_start = boost::chrono::steady_clock::now();
+					collateAndHandle(rx_message);
+					decode_profiler_(rx_message.messageNumber(), boost::chrono::duration_cast
+						<boost::chrono::nanoseconds>(boost::chrono::steady_clock::now() - handle_start).count());
+				}
 			}
 			catch (std::runtime_error& e) 
 			{
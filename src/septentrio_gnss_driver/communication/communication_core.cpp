@@ -29,6 +29,16 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
+// POSIX includes for the memory-mapped SBF file playback
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#if defined(__linux__)
+// For the low-latency serial port configuration (TIOCGSERIAL/TIOCSSERIAL)
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif
 
 /**
  * @file communication_core.cpp
@@ -36,7 +46,130 @@
  * @brief Highest-Level view on communication services
  */
  
-io_comm_rx::Comm_IO::Comm_IO(): handlers_() {}
+boost::shared_ptr<boost::asio::io_service> io_comm_rx::Comm_IO::shared_io_service_;
+boost::shared_ptr<boost::asio::io_service::work> io_comm_rx::Comm_IO::shared_io_work_;
+std::vector<boost::shared_ptr<boost::thread>> io_comm_rx::Comm_IO::shared_io_threads_;
+float io_comm_rx::Comm_IO::reconnect_initial_delay_s_ = 4.0;
+float io_comm_rx::Comm_IO::reconnect_max_delay_s_ = 60.0;
+float io_comm_rx::Comm_IO::serial_batching_latency_ms_ = 0.0;
+std::size_t io_comm_rx::Comm_IO::ring_capacity_ = 65536;
+
+io_comm_rx::Comm_IO::Comm_IO(): handlers_(), serial_mode_(false), udp_mode_(false), reconnecting_(false) {}
+
+io_comm_rx::Comm_IO::Comm_IO(std::size_t stream_id, const std::string& topic_prefix):
+	handlers_(stream_id, topic_prefix), serial_mode_(false), udp_mode_(false), reconnecting_(false) {}
+
+void io_comm_rx::Comm_IO::startIOThreadPool(std::size_t thread_pool_size)
+{
+	if (shared_io_service_)
+	{
+		ROS_ERROR("You have called the startIOThreadPool() method though the thread pool is already running!");
+		return;
+	}
+	ROS_DEBUG("Starting the shared io_service thread pool with %li threads..", thread_pool_size);
+	shared_io_service_.reset(new boost::asio::io_service);
+	// The work object keeps run() from returning in the (start-up) moments during which no
+	// async_read_some() is outstanding yet on any stream.
+	shared_io_work_.reset(new boost::asio::io_service::work(*shared_io_service_));
+	for (std::size_t i = 0; i < thread_pool_size; ++i)
+	{
+		shared_io_threads_.push_back(boost::shared_ptr<boost::thread>(new boost::thread(
+			boost::bind(&boost::asio::io_service::run, shared_io_service_))));
+		ThreadTuning::applyIO(*shared_io_threads_.back(), i);
+	}
+}
+
+void io_comm_rx::Comm_IO::configureReconnect(float initial_delay_s, float max_delay_s)
+{
+	reconnect_initial_delay_s_ = initial_delay_s;
+	reconnect_max_delay_s_ = max_delay_s;
+}
+
+void io_comm_rx::Comm_IO::configureSerialBatching(float max_latency_ms)
+{
+	serial_batching_latency_ms_ = max_latency_ms;
+}
+
+void io_comm_rx::Comm_IO::configureRingBuffer(std::size_t capacity_bytes)
+{
+	// The reader hands the ring chunks of up to the read buffer size (8192 bytes) at once; below twice
+	// that the zero-copy read path would permanently fall back to the staging copy and a single large
+	// chunk could evict most of the ring, hence the floor.
+	if (capacity_bytes < 16384)
+	{
+		ROS_WARN("A ring_buffer_size of %li bytes is too small to be useful, raising it to 16384.",
+			capacity_bytes);
+		capacity_bytes = 16384;
+	}
+	ring_capacity_ = capacity_bytes;
+}
+
+void io_comm_rx::Comm_IO::setReconnectedCallback(const boost::function<void()>& callback)
+{
+	reconnected_callback_ = callback;
+}
+
+void io_comm_rx::Comm_IO::handleConnectionLost()
+{
+	{
+		boost::mutex::scoped_lock lock(reconnect_mutex_);
+		if (reconnecting_) return;
+		reconnecting_ = true;
+	}
+	ROS_WARN("Connection to the Rx lost, reconnecting with exponential backoff..");
+	// Note that we are on the dying stream's I/O thread here: the reconnect loop runs on a thread of its
+	// own, since the teardown of the AsyncManager joins the very thread this method was invoked from.
+	boost::thread temporary_thread(boost::bind(&Comm_IO::reconnectLoop, this));
+	temporary_thread.detach();
+}
+
+void io_comm_rx::Comm_IO::reconnectLoop()
+{
+	ROS_DEBUG("Called reconnectLoop() method");
+	float delay_s = reconnect_initial_delay_s_;
+	while (ros::ok())
+	{
+		// The dead stream's AsyncManager is torn down first; its destructor stops and joins the stream's
+		// I/O and parser threads, after which setManager() below accepts the replacement.
+		manager_.reset();
+		ROS_INFO("Next reconnection attempt in %.1f seconds..", delay_s);
+		usleep(static_cast<unsigned int>(delay_s * 1000000.0f));
+		bool initialize_return = false;
+		try
+		{
+			if (serial_mode_)
+			{
+				ROS_INFO("Reconnecting serially to device %s, targeted baudrate: %u", serial_port_.c_str(),
+					baudrate_);
+				initialize_return = initializeSerial(serial_port_, baudrate_, flowcontrol_);
+			}
+			else if (udp_mode_)
+			{
+				ROS_INFO("Rebinding udp://%s:%s ...", host_.c_str(), port_.c_str());
+				initialize_return = initializeUDP(host_, port_);
+			}
+			else
+			{
+				ROS_INFO("Reconnecting to tcp://%s:%s ...", host_.c_str(), port_.c_str());
+				initialize_return = initializeTCP(host_, port_);
+			}
+		}
+		catch (std::runtime_error& e)
+		{
+			ROS_ERROR("Reconnection attempt failed due to: %s", e.what());
+		}
+		if (initialize_return) break;
+		// Exponential backoff: a receiver that is gone for a while (e.g. a vehicle in a tunnel) is not
+		// hammered with connection attempts, yet a briefly cycled cellular link is picked up again quickly.
+		delay_s = std::min(delay_s * 2.0f, reconnect_max_delay_s_);
+	}
+	{
+		boost::mutex::scoped_lock lock(reconnect_mutex_);
+		reconnecting_ = false;
+	}
+	if (ros::ok() && reconnected_callback_) reconnected_callback_();
+	ROS_DEBUG("Leaving reconnectLoop() method");
+}
 
 void io_comm_rx::Comm_IO::send(std::string cmd)
 {
@@ -49,9 +182,14 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
 	ROS_DEBUG("Calling initializeTCP() method..");
 	host_ = host;
 	port_ = port;
-	// The io_context, of which io_service is a typedef of; it represents your program's link to the 
-	// operating system's I/O services.
-	boost::shared_ptr<boost::asio::io_service> io_service(new boost::asio::io_service);
+	serial_mode_ = false;
+	udp_mode_ = false;
+	// The io_context, of which io_service is a typedef of; it represents your program's link to the
+	// operating system's I/O services. All streams share one io_service (and its thread pool) in case
+	// startIOThreadPool() was called, otherwise each stream gets its own.
+	bool shared_io_service = static_cast<bool>(shared_io_service_);
+	boost::shared_ptr<boost::asio::io_service> io_service = shared_io_service ? shared_io_service_ :
+		boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service);
 	boost::asio::ip::tcp::resolver::iterator endpoint;
 
 	try 
@@ -92,20 +230,151 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
 		ROS_ERROR("You have called the InitializeTCP() method though an AsyncManager object is already available! Start all anew..");
 		return false;
 	}
-	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::ip::tcp::socket>(socket, io_service)));
+	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::ip::tcp::socket>(socket, io_service,
+		8192, ring_capacity_, shared_io_service)));
 	ROS_DEBUG("Leaving initializeTCP() method..");
 	return true;
 }
 
- 
-bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate, std::string flowcontrol) 
+bool io_comm_rx::Comm_IO::initializeUDP(std::string host, std::string port)
+{
+	ROS_DEBUG("Calling initializeUDP() method..");
+	host_ = host;
+	port_ = port;
+	serial_mode_ = false;
+	udp_mode_ = true;
+	// Cf. initializeTCP(): all streams share one io_service (and its thread pool) in case
+	// startIOThreadPool() was called, otherwise each stream gets its own.
+	bool shared_io_service = static_cast<bool>(shared_io_service_);
+	boost::shared_ptr<boost::asio::io_service> io_service = shared_io_service ? shared_io_service_ :
+		boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service);
+
+	boost::shared_ptr<boost::asio::ip::udp::socket> socket(new boost::asio::ip::udp::socket(*io_service));
+
+	try
+	{
+		// The socket is bound to the given port on all local interfaces; SO_REUSEADDR s.t. several
+		// driver instances on one host can listen to one and the same multicast stream.
+		socket->open(boost::asio::ip::udp::v4());
+		socket->set_option(boost::asio::ip::udp::socket::reuse_address(true));
+		socket->bind(boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(),
+			static_cast<unsigned short>(std::stoi(port))));
+
+		boost::system::error_code address_error;
+		boost::asio::ip::address address = boost::asio::ip::address::from_string(host, address_error);
+		if (!address_error && address.is_multicast())
+		{
+			// One receiver multicasting its SBF stream can feed any number of driver instances, none
+			// of which talks back: the stream is ingest-only.
+			socket->set_option(boost::asio::ip::multicast::join_group(address));
+			ROS_INFO("Joined multicast group %s, listening on UDP port %s.", host.c_str(), port.c_str());
+		}
+		else if (!host.empty())
+		{
+			// Unicast: connecting the socket makes the kernel drop datagrams of unrelated senders.
+			boost::asio::ip::udp::resolver resolver(*io_service);
+			boost::asio::ip::udp::resolver::iterator endpoint = resolver.resolve(
+				boost::asio::ip::udp::resolver::query(boost::asio::ip::udp::v4(), host, port));
+			socket->connect(*endpoint);
+			ROS_INFO("Listening on UDP port %s for datagrams of %s.", port.c_str(), host.c_str());
+		}
+	}
+	catch (std::runtime_error& e)
+	{
+		throw std::runtime_error("Could not set up UDP socket for " + host + " on port " + port + ": " +
+			e.what());
+		return false;
+	}
+
+	if (manager_)
+	{
+		ROS_ERROR("You have called the InitializeUDP() method though an AsyncManager object is already available! Start all anew..");
+		return false;
+	}
+	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::ip::udp::socket>(socket, io_service,
+		8192, ring_capacity_, shared_io_service)));
+	ROS_DEBUG("Leaving initializeUDP() method..");
+	return true;
+}
+
+bool io_comm_rx::Comm_IO::initializeSBFFileReader(const std::string& file_path)
+{
+	ROS_DEBUG("Calling initializeSBFFileReader() method..");
+	int fd = open(file_path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		throw std::runtime_error("Could not open SBF file " + file_path + ": " + strerror(errno));
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0)
+	{
+		close(fd);
+		ROS_ERROR("SBF file %s is empty or its size could not be determined.", file_path.c_str());
+		return false;
+	}
+	std::size_t file_size = static_cast<std::size_t>(file_stat.st_size);
+	void* mapping = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after closing the file descriptor.
+	close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		throw std::runtime_error("Could not memory-map SBF file " + file_path + ": " + strerror(errno));
+		return false;
+	}
+	// We read the file front to back exactly once, so the kernel might as well read ahead aggressively
+	// and drop the pages behind us.
+	madvise(mapping, file_size, MADV_SEQUENTIAL);
+	const uint8_t* data = static_cast<const uint8_t*>(mapping);
+
+	ROS_INFO("Replaying SBF file %s (%li bytes) through the decode pipeline..", file_path.c_str(), file_size);
+	// The file is fed through the very same readCallback() the live streams use. The chunk size is
+	// arbitrary as long as it exceeds the maximum SBF block length by far: readCallback() throws the
+	// offset of the first byte of an incomplete trailing message, which simply becomes the start of the
+	// next chunk.
+	const std::size_t CHUNK_SIZE = 1048576;
+	std::size_t offset = 0;
+	while (offset < file_size && ros::ok())
+	{
+		std::size_t chunk = std::min(CHUNK_SIZE, file_size - offset);
+		try
+		{
+			handlers_.readCallback(data + offset, chunk);
+			offset += chunk;
+		}
+		catch (std::size_t& parsing_failed_here)
+		{
+			if (parsing_failed_here == 0)
+			{
+				// Can only happen in case a single message exceeds the chunk size (i.e. never for valid
+				// SBF/NMEA) or the file ends mid-message; either way there is no progress to be made.
+				ROS_WARN("SBF file %s ends with an incomplete message, %li bytes were not replayed.",
+					file_path.c_str(), file_size - offset);
+				break;
+			}
+			offset += parsing_failed_here;
+		}
+	}
+	munmap(mapping, file_size);
+	ROS_INFO("Finished replaying SBF file %s.", file_path.c_str());
+	ROS_DEBUG("Leaving initializeSBFFileReader() method..");
+	return true;
+}
+
+bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate, std::string flowcontrol)
 {
 	ROS_DEBUG("Calling initializeSerial() method..");
 	serial_port_ = port;
 	baudrate_ = baudrate;
-	// The io_context, of which io_service is a typedef of; it represents your program's link to the 
-	// operating system's I/O services.
-	boost::shared_ptr<boost::asio::io_service> io_service(new boost::asio::io_service); 
+	flowcontrol_ = flowcontrol;
+	serial_mode_ = true;
+	udp_mode_ = false;
+	// The io_context, of which io_service is a typedef of; it represents your program's link to the
+	// operating system's I/O services. All streams share one io_service (and its thread pool) in case
+	// startIOThreadPool() was called, otherwise each stream gets its own.
+	bool shared_io_service = static_cast<bool>(shared_io_service_);
+	boost::shared_ptr<boost::asio::io_service> io_service = shared_io_service ? shared_io_service_ :
+		boost::shared_ptr<boost::asio::io_service>(new boost::asio::io_service);
 	// To perform I/O operations the program needs an I/O object, here "serial".
 	boost::shared_ptr<boost::asio::serial_port> serial(new boost::asio::serial_port(*io_service));
 
@@ -150,11 +419,39 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
 		// Setting serial port to "raw" mode to prevent EOF exit..
 		cfmakeraw(&tio);
 		
-		// Commit settings, syntax is 
+		// Commit settings, syntax is
 		// int tcsetattr(int fd, int optional_actions, const struct termios *termios_p);
 		tcsetattr(fd, TCSANOW, &tio);
 	}
 
+#if defined(__linux__)
+	{
+		// USB-serial adapters (e.g. the FTDI-based ones) batch incoming bytes with a latency timer of
+		// up to 16ms by default - ingest delay pure and simple. ASYNC_LOW_LATENCY drops that timer to
+		// its minimum; where fewer, larger reads are preferred over raw latency, the batching is then
+		// performed in userspace against the configured latency budget instead, cf. the read_batching_us
+		// parameter of the AsyncManager class. Note that kernel-side VMIN/VTIME tuning would not help
+		// here: ASIO reads the port non-blockingly, and those settings apply to blocking reads only.
+		struct serial_struct serial_info;
+		int fd = serial->native_handle();
+		if (ioctl(fd, TIOCGSERIAL, &serial_info) == 0)
+		{
+			serial_info.flags |= ASYNC_LOW_LATENCY;
+			if (ioctl(fd, TIOCSSERIAL, &serial_info) != 0)
+			{
+				ROS_DEBUG("Could not put serial port %s into low-latency mode: %s", serial_port_.c_str(),
+					strerror(errno));
+			}
+		}
+		else
+		{
+			// E.g. USB CDC-ACM ports (ttyACMx) know no latency timer in the first place.
+			ROS_DEBUG("Serial port %s does not expose the TIOCGSERIAL interface, leaving its latency timer alone.",
+				serial_port_.c_str());
+		}
+	}
+#endif
+
 	// Set the I/O manager
 	if (manager_) 
 	{
@@ -162,7 +459,9 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
 		return false;
 	}
 	ROS_DEBUG("Creating new Async-Manager object..");
-	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::serial_port>(serial, io_service)));
+	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::serial_port>(serial, io_service,
+		8192, ring_capacity_, shared_io_service,
+		static_cast<std::size_t>(serial_batching_latency_ms_ * 1000.0f))));
 	
 	// Setting the baudrate, incrementally..
 	ROS_DEBUG("Gradually increasing the baudrate to the desired value...");
@@ -240,9 +539,10 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
 void io_comm_rx::Comm_IO::setManager(const boost::shared_ptr<Manager>& manager) 
 {
 	ROS_DEBUG("Called setManager() method");
-	if (manager_) return; 
+	if (manager_) return;
 	manager_ = manager;
-	manager_->setCallback(boost::bind(&CallbackHandlers::readCallback, &handlers_, _1, _2));
+	manager_->setCallback(boost::bind(&CallbackHandlers::readCallback, &handlers_, _1, _2, _3));
+	manager_->setConnectionLostCallback(boost::bind(&Comm_IO::handleConnectionLost, this));
 	ROS_DEBUG("Leaving setManager() method");
 }
 
@@ -266,7 +566,8 @@ void io_comm_rx::Comm_IO::resetSerial(std::string port)
 
 	// Sets the I/O worker
 	if (manager_) return;
-	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::serial_port>(serial, io_service)));
+	setManager(boost::shared_ptr<Manager>(new AsyncManager<boost::asio::serial_port>(serial, io_service,
+		8192, ring_capacity_)));
 	
 	// Set the baudrate
 	serial->set_option(boost::asio::serial_port_base::baud_rate(baudrate_));
@@ -0,0 +1,147 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/decode_worker_pool.hpp>
+#include <septentrio_gnss_driver/communication/callback_handlers.hpp>
+#include <septentrio_gnss_driver/communication/pipeline_stats.hpp>
+
+/**
+ * @file decode_worker_pool.cpp
+ * @date 01/09/26
+ * @brief Pool of worker threads decoding and publishing complete frames behind the frame scanner
+ */
+
+namespace io_comm_rx
+{
+	DecodeWorkerPool* DecodeWorkerPool::instance_ = NULL;
+
+	void DecodeWorkerPool::configure(uint32_t thread_count)
+	{
+		if (thread_count == 0) return;
+		if (instance_ != NULL)
+		{
+			ROS_WARN("Decode worker pool configured twice, keeping the first configuration..");
+			return;
+		}
+		instance_ = new DecodeWorkerPool(thread_count);
+		ROS_DEBUG("Decode worker pool spawned with %u worker thread(s)..", thread_count);
+	}
+
+	DecodeWorkerPool* DecodeWorkerPool::instance()
+	{
+		return instance_;
+	}
+
+	DecodeWorkerPool::DecodeWorkerPool(uint32_t thread_count) :
+		stopping_(false)
+	{
+		for (uint32_t i = 0; i < thread_count; ++i)
+		{
+			queues_.push_back(boost::shared_ptr<WorkerQueue>(new WorkerQueue()));
+		}
+		// The queues must all exist before the first worker starts popping, hence the second loop
+		for (uint32_t i = 0; i < thread_count; ++i)
+		{
+			workers_.push_back(boost::shared_ptr<boost::thread>(new boost::thread(
+				boost::bind(&DecodeWorkerPool::work, this, static_cast<std::size_t>(i)))));
+		}
+	}
+
+	DecodeWorkerPool::~DecodeWorkerPool()
+	{
+		for (std::size_t i = 0; i < queues_.size(); ++i)
+		{
+			boost::mutex::scoped_lock lock(queues_[i]->mutex);
+			stopping_ = true;
+			lock.unlock();
+			queues_[i]->pushed.notify_one();
+		}
+		for (std::size_t i = 0; i < workers_.size(); ++i)
+		{
+			workers_[i]->join();
+		}
+	}
+
+	void DecodeWorkerPool::enqueue(CallbackHandlers* handlers, RxIDType message_key,
+		const uint8_t* frame, std::size_t size, const ros::Time& ingest_stamp)
+	{
+		// All composite constituents pin to one and the same worker (index 0): their collators, last_..
+		// copies and do_.. triggers are one shared state machine, and spreading them by block ID would
+		// let a fast worker decode epoch T+1's PVTGeodetic - overwriting its last_.. copy - before a
+		// slower worker completes epoch T, assembling that epoch's composite messages from mixed epochs.
+		// Pinning them together keeps the whole constituent stream in arrival order, cf. the class
+		// description; every other message type still hashes over all workers, worker 0 included.
+		std::size_t worker_index = CallbackHandlers::isCompositeConstituent(message_key) ?
+			0 : static_cast<std::size_t>(message_key) % queues_.size();
+		WorkerQueue& queue = *queues_[worker_index];
+		DecodeJob job;
+		job.handlers = handlers;
+		job.frame.assign(frame, frame + size);
+		boost::mutex::scoped_lock lock(queue.mutex);
+		// Bounded queue: blocking here backs the stream up into the ring buffer rather than letting a
+		// slow worker grow its inbox without limit
+		queue.popped.wait(lock, [&queue](){return queue.jobs.size() < MAX_QUEUED_FRAMES;});
+		queue.jobs.push_back(DecodeJob());
+		// The frame's bytes change owners without being copied a second time
+		queue.jobs.back().handlers = job.handlers;
+		queue.jobs.back().frame.swap(job.frame);
+		queue.jobs.back().ingest_stamp = ingest_stamp;
+		// enqueue() runs on the parser thread, whose thread-local chunk stamp readCallback() seeded via
+		// markChunkStart(); the steady-clock copy travels with the job s.t. the worker measures its
+		// ingest-to-publish latency against the frame's true ingest, cf. work()
+		queue.jobs.back().ingest_ns = PipelineStats::chunkStartNS();
+		lock.unlock();
+		queue.pushed.notify_one();
+	}
+
+	void DecodeWorkerPool::work(std::size_t worker_index)
+	{
+		WorkerQueue& queue = *queues_[worker_index];
+		while (true)
+		{
+			DecodeJob job;
+			{
+				boost::mutex::scoped_lock lock(queue.mutex);
+				queue.pushed.wait(lock, [this, &queue](){return stopping_ || !queue.jobs.empty();});
+				// Whatever was enqueued before the pool stops is still decoded and published
+				if (queue.jobs.empty()) return;
+				job.handlers = queue.jobs.front().handlers;
+				job.frame.swap(queue.jobs.front().frame);
+				job.ingest_stamp = queue.jobs.front().ingest_stamp;
+				job.ingest_ns = queue.jobs.front().ingest_ns;
+				queue.jobs.pop_front();
+				lock.unlock();
+				queue.popped.notify_one();
+			}
+			PipelineStats::seedChunkStart(job.ingest_ns);
+			job.handlers->handleFrame(job.frame.data(), job.frame.size(), job.ingest_stamp);
+		}
+	}
+}
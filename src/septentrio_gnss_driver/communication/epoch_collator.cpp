@@ -0,0 +1,82 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/epoch_collator.hpp>
+
+/**
+ * @file epoch_collator.cpp
+ * @date 01/09/26
+ * @brief Groups the constituent SBF blocks of a composite ROS message by their TOW/WNc epoch
+ */
+
+io_comm_rx::EpochCollator::EpochCollator(uint32_t complete_mask) :
+	size_(0), complete_mask_(complete_mask) {}
+
+bool io_comm_rx::EpochCollator::collate(uint32_t constituent_bit, uint32_t tow, uint16_t wnc)
+{
+	uint64_t key = epochKey(tow, wnc);
+	for (std::size_t i = 0; i < size_; ++i)
+	{
+		if (pending_[i].key != key) continue;
+		pending_[i].arrived_mask |= constituent_bit;
+		if (pending_[i].arrived_mask != complete_mask_) return false;
+		// The completed epoch is retired together with every older pending one: the Rx emits the blocks
+		// of each type in chronological order, hence an older epoch can only still be missing blocks that
+		// will never arrive anymore, and emitting it after a newer epoch would break the composite
+		// message's monotonicity anyway.
+		std::size_t kept = 0;
+		for (std::size_t j = 0; j < size_; ++j)
+		{
+			if (pending_[j].key > key) pending_[kept++] = pending_[j];
+		}
+		size_ = kept;
+		return true;
+	}
+	// First constituent of a yet unknown epoch
+	if (constituent_bit == complete_mask_) return true; // A single-constituent composite never pends
+	std::size_t slot = size_;
+	if (size_ == MAX_PENDING_EPOCHS)
+	{
+		// The table is full: the oldest pending epoch is aged out, which is where epochs that will never
+		// complete (e.g. with one constituent lost to a CRC failure) end their life.
+		slot = 0;
+		for (std::size_t i = 1; i < MAX_PENDING_EPOCHS; ++i)
+		{
+			if (pending_[i].key < pending_[slot].key) slot = i;
+		}
+	}
+	else
+	{
+		++size_;
+	}
+	pending_[slot].key = key;
+	pending_[slot].arrived_mask = constituent_bit;
+	return false;
+}
@@ -0,0 +1,107 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/pipeline_stats.hpp>
+// C++ library includes
+#include <string>
+
+/**
+ * @file pipeline_stats.cpp
+ * @date 01/09/26
+ * @brief Always-on hot-path instrumentation: latency histograms and stream-health counters
+ */
+
+const std::size_t io_comm_rx::PipelineStats::BUCKET_COUNT;
+std::atomic<uint64_t> io_comm_rx::PipelineStats::parse_histogram_[BUCKET_COUNT];
+std::atomic<uint64_t> io_comm_rx::PipelineStats::publish_histogram_[BUCKET_COUNT];
+std::atomic<uint64_t> io_comm_rx::PipelineStats::pending_ingest_ns_(0);
+std::atomic<uint64_t> io_comm_rx::PipelineStats::ring_high_water_(0);
+std::atomic<uint64_t> io_comm_rx::PipelineStats::crc_failures_(0);
+std::atomic<uint64_t> io_comm_rx::PipelineStats::resyncs_(0);
+std::atomic<uint64_t> io_comm_rx::PipelineStats::overflow_drops_(0);
+std::atomic<uint64_t> io_comm_rx::PipelineStats::overflow_dropped_bytes_(0);
+thread_local uint64_t io_comm_rx::PipelineStats::chunk_ingest_ns_ = 0;
+
+double io_comm_rx::PipelineStats::quantileUS(const std::atomic<uint64_t>* histogram, double quantile)
+{
+	uint64_t total = 0;
+	for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+	{
+		total += histogram[bucket].load(std::memory_order_relaxed);
+	}
+	if (total == 0) return 0.0;
+	// The smallest bucket whose cumulative count reaches the quantile holds the sought latency; its upper
+	// bound 2^(bucket+1) ns is reported, i.e. quantiles are correct up to the factor-of-two granularity.
+	uint64_t cumulative = 0;
+	for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+	{
+		cumulative += histogram[bucket].load(std::memory_order_relaxed);
+		if (cumulative >= quantile * total)
+		{
+			// Capped at 63 merely to keep the shift well-defined for the (never reached) topmost bucket
+			return static_cast<double>(uint64_t(1) << (bucket + 1 < 64 ? bucket + 1 : 63)) / 1e3;
+		}
+	}
+	return 0.0;
+}
+
+diagnostic_msgs::DiagnosticStatus io_comm_rx::PipelineStats::pipelineStatus()
+{
+	diagnostic_msgs::DiagnosticStatus status;
+	status.name = "Pipeline";
+	status.message = "ROSaic hot-path latency (log2-bucket quantiles) and stream-health counters";
+	// CRC failures and resyncs occur sporadically on noisy serial lines; a corrupted stream produces them
+	// in streaks, which is worth a warning whenever any arose since startup. An overflow eviction means
+	// whole epochs were lost, cf. the overflow policy of the SPSCRingBuffer class - equally warning-worthy.
+	status.level = (crc_failures_.load(std::memory_order_relaxed) == 0 &&
+		resyncs_.load(std::memory_order_relaxed) == 0 &&
+		overflow_drops_.load(std::memory_order_relaxed) == 0) ?
+		diagnostic_msgs::DiagnosticStatus::OK : diagnostic_msgs::DiagnosticStatus::WARN;
+	status.values.resize(9);
+	status.values[0].key = "Ingest-to-Parse Latency, p50 [us]";
+	status.values[0].value = std::to_string(quantileUS(parse_histogram_, 0.5));
+	status.values[1].key = "Ingest-to-Parse Latency, p99 [us]";
+	status.values[1].value = std::to_string(quantileUS(parse_histogram_, 0.99));
+	status.values[2].key = "Ingest-to-Publish Latency, p50 [us]";
+	status.values[2].value = std::to_string(quantileUS(publish_histogram_, 0.5));
+	status.values[3].key = "Ingest-to-Publish Latency, p99 [us]";
+	status.values[3].value = std::to_string(quantileUS(publish_histogram_, 0.99));
+	status.values[4].key = "Ring Occupancy High-Water Mark [bytes]";
+	status.values[4].value = std::to_string(ring_high_water_.load(std::memory_order_relaxed));
+	status.values[5].key = "CRC Failures";
+	status.values[5].value = std::to_string(crc_failures_.load(std::memory_order_relaxed));
+	status.values[6].key = "Resyncs";
+	status.values[6].value = std::to_string(resyncs_.load(std::memory_order_relaxed));
+	status.values[7].key = "Ring Overflow Evictions";
+	status.values[7].value = std::to_string(overflow_drops_.load(std::memory_order_relaxed));
+	status.values[8].key = "Ring Overflow Dropped Bytes";
+	status.values[8].value = std::to_string(overflow_dropped_bytes_.load(std::memory_order_relaxed));
+	return status;
+}
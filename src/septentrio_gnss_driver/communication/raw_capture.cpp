@@ -0,0 +1,197 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/raw_capture.hpp>
+// ROS includes
+#include <ros/console.h>
+// POSIX includes for the batched file writes
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+/**
+ * @file raw_capture.cpp
+ * @date 01/09/26
+ * @brief Lossless raw logging of the receiver's byte stream to an on-disk ring of pre-allocated files
+ */
+
+//! Size of each of the two in-memory buffers; also the largest batch a single write() will carry
+static const std::size_t CAPTURE_BUFFER_SIZE = 1048576;
+//! Fill level at which append() pokes the writer thread rather than waiting for the next swap
+static const std::size_t CAPTURE_FLUSH_THRESHOLD = 262144;
+
+bool io_comm_rx::RawCapture::enabled_ = false;
+std::string io_comm_rx::RawCapture::directory_ = "/tmp";
+std::size_t io_comm_rx::RawCapture::max_file_size_ = 268435456;
+std::size_t io_comm_rx::RawCapture::file_count_ = 4;
+std::size_t io_comm_rx::RawCapture::instance_counter_ = 0;
+
+void io_comm_rx::RawCapture::configure(bool enabled, const std::string& directory,
+	std::size_t max_file_size_mb, std::size_t file_count)
+{
+	enabled_ = enabled;
+	directory_ = directory;
+	max_file_size_ = max_file_size_mb * 1048576;
+	file_count_ = (file_count == 0) ? 1 : file_count;
+}
+
+boost::shared_ptr<io_comm_rx::RawCapture> io_comm_rx::RawCapture::createIfEnabled()
+{
+	if (!enabled_) return boost::shared_ptr<RawCapture>();
+	return boost::shared_ptr<RawCapture>(new RawCapture(instance_counter_++));
+}
+
+io_comm_rx::RawCapture::RawCapture(std::size_t instance_id) : instance_id_(instance_id), active_(0),
+	dropped_bytes_(0), stopping_(false), fd_(-1), bytes_in_file_(0), ring_slot_(0)
+{
+	buffers_[0].resize(CAPTURE_BUFFER_SIZE);
+	buffers_[1].resize(CAPTURE_BUFFER_SIZE);
+	fill_[0] = 0;
+	fill_[1] = 0;
+	openFile(0);
+	ROS_DEBUG("Launching the raw capture writer thread for stream %li..", instance_id_);
+	write_thread_.reset(new boost::thread(boost::bind(&RawCapture::writeLoop, this)));
+}
+
+io_comm_rx::RawCapture::~RawCapture()
+{
+	{
+		boost::mutex::scoped_lock lock(mutex_);
+		stopping_ = true;
+	}
+	write_condition_.notify_one();
+	write_thread_->join();
+	if (fd_ != -1) close(fd_);
+	if (dropped_bytes_ != 0)
+	{
+		ROS_WARN("Raw capture of stream %li dropped %li bytes since the disk could not keep up.",
+			instance_id_, dropped_bytes_);
+	}
+}
+
+void io_comm_rx::RawCapture::openFile(std::size_t ring_slot)
+{
+	if (fd_ != -1) close(fd_);
+	ring_slot_ = ring_slot;
+	bytes_in_file_ = 0;
+	std::string path = directory_ + "/rosaic_raw_stream" + std::to_string(instance_id_) + "_" +
+		std::to_string(ring_slot_) + ".sbf";
+	fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd_ == -1)
+	{
+		ROS_ERROR("Could not open raw capture file %s: %s", path.c_str(), strerror(errno));
+		return;
+	}
+	// Pre-allocating the whole file up front s.t. later write()s never stall on block allocation;
+	// not every filesystem supports it, in which case the writes simply grow the file as usual.
+	if (posix_fallocate(fd_, 0, static_cast<off_t>(max_file_size_)) != 0)
+	{
+		ROS_DEBUG("posix_fallocate() is unsupported on the filesystem holding %s.", path.c_str());
+	}
+	ROS_INFO("Raw capture of stream %li now writing to %s.", instance_id_, path.c_str());
+}
+
+void io_comm_rx::RawCapture::append(const uint8_t* data, std::size_t size)
+{
+	if (size == 0 || size > CAPTURE_BUFFER_SIZE) return;
+	bool poke = false;
+	{
+		boost::mutex::scoped_lock lock(mutex_);
+		if (fill_[active_] + size > CAPTURE_BUFFER_SIZE)
+		{
+			// The active buffer cannot take the chunk; in case the writer has already drained the other
+			// buffer we swap right away, otherwise the disk has fallen behind both buffers and the chunk
+			// is dropped rather than the I/O thread stalled.
+			std::size_t spare = 1 - active_;
+			if (fill_[spare] != 0)
+			{
+				dropped_bytes_ += size;
+				return;
+			}
+			active_ = spare;
+			poke = true;
+		}
+		memcpy(buffers_[active_].data() + fill_[active_], data, size);
+		fill_[active_] += size;
+		if (fill_[active_] >= CAPTURE_FLUSH_THRESHOLD) poke = true;
+	}
+	if (poke) write_condition_.notify_one();
+}
+
+void io_comm_rx::RawCapture::writeLoop()
+{
+	while (true)
+	{
+		std::size_t write_index;
+		std::size_t write_size;
+		{
+			boost::mutex::scoped_lock lock(mutex_);
+			// Waking up once a second also bounds how long a trickle of bytes can linger unbatched in memory.
+			write_condition_.wait_for(lock, boost::chrono::seconds(1),
+				[this](){return stopping_ || fill_[active_] >= CAPTURE_FLUSH_THRESHOLD;});
+			if (fill_[active_] == 0 && stopping_) break;
+			if (fill_[active_] == 0) continue;
+			// Swapping under the lock is index arithmetic only; the write() below runs unlocked while
+			// append() keeps filling the other buffer.
+			write_index = active_;
+			active_ = 1 - active_;
+			write_size = fill_[write_index];
+		}
+		if (fd_ != -1)
+		{
+			std::size_t written = 0;
+			while (written < write_size)
+			{
+				ssize_t result = write(fd_, buffers_[write_index].data() + written, write_size - written);
+				if (result <= 0)
+				{
+					ROS_ERROR("Raw capture write failed: %s", strerror(errno));
+					break;
+				}
+				written += static_cast<std::size_t>(result);
+			}
+			bytes_in_file_ += written;
+			if (bytes_in_file_ >= max_file_size_)
+			{
+				// The file is full: if it was pre-allocated beyond its content, give the excess back,
+				// then rotate to the ring's next slot, overwriting the oldest file once the ring is full.
+				if (ftruncate(fd_, static_cast<off_t>(bytes_in_file_)) != 0) {}
+				openFile((ring_slot_ + 1) % file_count_);
+			}
+		}
+		{
+			boost::mutex::scoped_lock lock(mutex_);
+			fill_[write_index] = 0;
+		}
+	}
+	// Trim the pre-allocation of the final file s.t. it ends exactly with the last captured byte.
+	if (fd_ != -1 && ftruncate(fd_, static_cast<off_t>(bytes_in_file_)) != 0) {}
+}
@@ -29,6 +29,11 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/communication/rx_message.hpp>
+#include <septentrio_gnss_driver/packed_structs/sbf_field_mapping.hpp>
+// Intrinsics for the vectorized sync byte scanner, only available on x86
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /**
  * @file rx_message.cpp
@@ -36,6 +41,16 @@
  * @brief Defines a class that reads messages handed over from the circular buffer
  */
  
+//! Sized to the full stream and key range upon construction s.t. the hot publish() path never mutates the
+//! vectors themselves
+std::vector<std::vector<ros::Publisher>> io_comm_rx::PublisherRegistry::publishers_(MAX_RX_STREAMS,
+	std::vector<ros::Publisher>(RX_ID_TABLE_SIZE));
+boost::mutex io_comm_rx::PublisherRegistry::mutex_;
+bool io_comm_rx::PublisherRegistry::stubbed_ = false;
+io_comm_rx::PublishSink* io_comm_rx::PublisherRegistry::sink_ = NULL;
+boost::shared_ptr<ros::NodeHandle> io_comm_rx::PublisherRegistry::nh_;
+bool io_comm_rx::PublisherRegistry::intra_process_ = false;
+
 uint32_t io_comm_rx::RxMessage::count_gpsfix_ = 0;
 PVTGeodetic io_comm_rx::RxMessage::last_pvtgeodetic_ = PVTGeodetic();
 PosCovGeodetic io_comm_rx::RxMessage::last_poscovgeodetic_ = PosCovGeodetic();
@@ -66,206 +81,137 @@ std::pair<uint16_t, TypeOfPVT_Enum> type_of_pvt_pairs[] =
 
 io_comm_rx::RxMessage::TypeOfPVTMap io_comm_rx::RxMessage::type_of_pvt_map(type_of_pvt_pairs, type_of_pvt_pairs + evPPP + 1);
 
-//! Pair of iterators to facilitate initialization of the map
-std::pair<std::string, RxID_Enum> rx_id_pairs[] =
+RxID_Enum io_comm_rx::RxMessage::idToEnum(RxIDType id)
 {
-	std::make_pair("NavSatFix", evNavSatFix),
-	std::make_pair("GPSFix", evGPSFix),
-	std::make_pair("PoseWithCovarianceStamped", evPoseWithCovarianceStamped),
-	std::make_pair("$GPGGA", evGPGGA),
-	std::make_pair("$GPRMC", evGPRMC),
-	std::make_pair("$GPGSA", evGPGSA),
-	std::make_pair("$GPGSV", evGPGSV),
-	std::make_pair("$GLGSV", evGLGSV),
-	std::make_pair("$GAGSV", evGAGSV),
-	std::make_pair("4006", evPVTCartesian),
-	std::make_pair("4007", evPVTGeodetic),
-	std::make_pair("5905", evPosCovCartesian),
-	std::make_pair("5906", evPosCovGeodetic),
-	std::make_pair("5938", evAttEuler),
-	std::make_pair("5939", evAttCovEuler),
-	std::make_pair("GPST", evGPST),
-	std::make_pair("4013", evChannelStatus),
-	std::make_pair("4027", evMeasEpoch),
-	std::make_pair("4001", evDOP),
-	std::make_pair("5908", evVelCovGeodetic),
-	std::make_pair("DiagnosticArray", evDiagnosticArray),
-	std::make_pair("4014", evReceiverStatus),
-	std::make_pair("4082", evQualityInd),
-	std::make_pair("5902", evReceiverSetup)
-};
-
-io_comm_rx::RxMessage::RxIDMap io_comm_rx::RxMessage::rx_id_map(rx_id_pairs, rx_id_pairs + evReceiverSetup+1);
+	switch (id)
+	{
+		case RX_ID_NAVSATFIX:					return evNavSatFix;
+		case RX_ID_GPSFIX:						return evGPSFix;
+		case RX_ID_POSEWITHCOVARIANCESTAMPED:	return evPoseWithCovarianceStamped;
+		case RX_ID_GPGGA:						return evGPGGA;
+		case RX_ID_GPRMC:						return evGPRMC;
+		case RX_ID_GPGSA:						return evGPGSA;
+		case RX_ID_GPGSV:						return evGPGSV;
+		case RX_ID_GLGSV:						return evGLGSV;
+		// All GSV talkers are parsed by the very same case label in rx_message.hpp, hence mapping the
+		// BeiDou talker onto evGAGSV is fine
+		case RX_ID_GAGSV: case RX_ID_GBGSV:		return evGAGSV;
+		case 4006:								return evPVTCartesian;
+		case 4007:								return evPVTGeodetic;
+		case 5905:								return evPosCovCartesian;
+		case 5906:								return evPosCovGeodetic;
+		case 5938:								return evAttEuler;
+		case 5939:								return evAttCovEuler;
+		case RX_ID_GPST:						return evGPST;
+		case 4013:								return evChannelStatus;
+		case 4027:								return evMeasEpoch;
+		case 4001:								return evDOP;
+		case 5908:								return evVelCovGeodetic;
+		case RX_ID_DIAGNOSTICARRAY:				return evDiagnosticArray;
+		case 4014:								return evReceiverStatus;
+		case 4082:								return evQualityInd;
+		case 5902:								return evReceiverSetup;
+		default:								return evRxIDUnknown;
+	}
+}
 
 septentrio_gnss_driver::PVTGeodeticPtr io_comm_rx::RxMessage::PVTGeodeticCallback(PVTGeodetic& data)
 {
-	septentrio_gnss_driver::PVTGeodeticPtr msg = boost::make_shared<septentrio_gnss_driver::PVTGeodetic>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->mode = data.mode;
-	msg->error = data.error;
-	msg->latitude = data.latitude;
-	msg->longitude = data.longitude;
-	msg->height = data.height;
-	msg->undulation = data.undulation;
-	msg->vn = data.vn;
-	msg->ve = data.ve;
-	msg->vu = data.vu;
-	msg->cog = data.cog;
-	msg->rx_clk_bias = data.rx_clk_bias;
-	msg->rx_clk_drift = data.rx_clk_drift;
-	msg->time_system = data.time_system;
-	msg->datum = data.datum;
-	msg->nr_sv = data.nr_sv;
-	msg->wa_corr_info = data.wa_corr_info;
-	msg->reference_id = data.reference_id;
-	msg->mean_corr_age = data.mean_corr_age;
-	msg->signal_info = data.signal_info;
-	msg->alert_flag = data.alert_flag;
-	msg->nr_bases = data.nr_bases;
-	msg->ppp_info = data.ppp_info;
-	msg->latency = data.latency;
-	msg->h_accuracy = data.h_accuracy;
-	msg->v_accuracy = data.v_accuracy;
-	msg->misc = data.misc;
+	static MessagePool<septentrio_gnss_driver::PVTGeodetic> pool;
+	septentrio_gnss_driver::PVTGeodeticPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::PVTGeodetic MsgType;
+	typedef PVTGeodetic DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(mode), SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(latitude),
+		SBF_MAPPED_FIELD(longitude), SBF_MAPPED_FIELD(height), SBF_MAPPED_FIELD(undulation),
+		SBF_MAPPED_FIELD(vn), SBF_MAPPED_FIELD(ve), SBF_MAPPED_FIELD(vu),
+		SBF_MAPPED_FIELD(cog), SBF_MAPPED_FIELD(rx_clk_bias), SBF_MAPPED_FIELD(rx_clk_drift),
+		SBF_MAPPED_FIELD(time_system), SBF_MAPPED_FIELD(datum), SBF_MAPPED_FIELD(nr_sv),
+		SBF_MAPPED_FIELD(wa_corr_info), SBF_MAPPED_FIELD(reference_id), SBF_MAPPED_FIELD(mean_corr_age),
+		SBF_MAPPED_FIELD(signal_info), SBF_MAPPED_FIELD(alert_flag), SBF_MAPPED_FIELD(nr_bases),
+		SBF_MAPPED_FIELD(ppp_info), SBF_MAPPED_FIELD(latency), SBF_MAPPED_FIELD(h_accuracy),
+		SBF_MAPPED_FIELD(v_accuracy), SBF_MAPPED_FIELD(misc));
 	return msg;
 }
 
 
 septentrio_gnss_driver::PVTCartesianPtr io_comm_rx::RxMessage::PVTCartesianCallback(PVTCartesian& data)
 {
-	septentrio_gnss_driver::PVTCartesianPtr msg = boost::make_shared<septentrio_gnss_driver::PVTCartesian>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->mode = data.mode;
-	msg->error = data.error;
-	msg->x = data.x;
-	msg->y = data.y;
-	msg->z = data.z;
-	msg->undulation = data.undulation;
-	msg->vx = data.vx;
-	msg->vy = data.vy;
-	msg->vz = data.vz;
-	msg->cog = data.cog;
-	msg->rx_clk_bias = data.rx_clk_bias;
-	msg->rx_clk_drift = data.rx_clk_drift;
-	msg->time_system = data.time_system;
-	msg->datum = data.datum;
-	msg->nr_sv = data.nr_sv;
-	msg->wa_corr_info = data.wa_corr_info;
-	msg->reference_id = data.reference_id;
-	msg->mean_corr_age = data.mean_corr_age;
-	msg->signal_info = data.signal_info;
-	msg->alert_flag = data.alert_flag;
-	msg->nr_bases = data.nr_bases;
-	msg->ppp_info = data.ppp_info;
-	msg->latency = data.latency;
-	msg->h_accuracy = data.h_accuracy;
-	msg->v_accuracy = data.v_accuracy;
-	msg->misc = data.misc;
+	static MessagePool<septentrio_gnss_driver::PVTCartesian> pool;
+	septentrio_gnss_driver::PVTCartesianPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::PVTCartesian MsgType;
+	typedef PVTCartesian DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(mode), SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(x),
+		SBF_MAPPED_FIELD(y), SBF_MAPPED_FIELD(z), SBF_MAPPED_FIELD(undulation),
+		SBF_MAPPED_FIELD(vx), SBF_MAPPED_FIELD(vy), SBF_MAPPED_FIELD(vz),
+		SBF_MAPPED_FIELD(cog), SBF_MAPPED_FIELD(rx_clk_bias), SBF_MAPPED_FIELD(rx_clk_drift),
+		SBF_MAPPED_FIELD(time_system), SBF_MAPPED_FIELD(datum), SBF_MAPPED_FIELD(nr_sv),
+		SBF_MAPPED_FIELD(wa_corr_info), SBF_MAPPED_FIELD(reference_id), SBF_MAPPED_FIELD(mean_corr_age),
+		SBF_MAPPED_FIELD(signal_info), SBF_MAPPED_FIELD(alert_flag), SBF_MAPPED_FIELD(nr_bases),
+		SBF_MAPPED_FIELD(ppp_info), SBF_MAPPED_FIELD(latency), SBF_MAPPED_FIELD(h_accuracy),
+		SBF_MAPPED_FIELD(v_accuracy), SBF_MAPPED_FIELD(misc));
 	return msg;
 }
 
 septentrio_gnss_driver::PosCovCartesianPtr io_comm_rx::RxMessage::PosCovCartesianCallback(PosCovCartesian& data)
 {
-	septentrio_gnss_driver::PosCovCartesianPtr msg = boost::make_shared<septentrio_gnss_driver::PosCovCartesian>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->mode = data.mode;
-	msg->error = data.error;
-	msg->cov_xx = data.cov_xx;
-	msg->cov_yy = data.cov_yy;
-	msg->cov_zz = data.cov_zz;
-	msg->cov_bb = data.cov_bb;
-	msg->cov_xy = data.cov_xy;
-	msg->cov_xz = data.cov_xz;
-	msg->cov_xb = data.cov_xb;
-	msg->cov_yz = data.cov_yz;
-	msg->cov_yb = data.cov_yb;
-	msg->cov_zb = data.cov_zb;
+	static MessagePool<septentrio_gnss_driver::PosCovCartesian> pool;
+	septentrio_gnss_driver::PosCovCartesianPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::PosCovCartesian MsgType;
+	typedef PosCovCartesian DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(mode), SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(cov_xx),
+		SBF_MAPPED_FIELD(cov_yy), SBF_MAPPED_FIELD(cov_zz), SBF_MAPPED_FIELD(cov_bb),
+		SBF_MAPPED_FIELD(cov_xy), SBF_MAPPED_FIELD(cov_xz), SBF_MAPPED_FIELD(cov_xb),
+		SBF_MAPPED_FIELD(cov_yz), SBF_MAPPED_FIELD(cov_yb), SBF_MAPPED_FIELD(cov_zb));
 	return msg;
 }
 
 
 septentrio_gnss_driver::PosCovGeodeticPtr io_comm_rx::RxMessage::PosCovGeodeticCallback(PosCovGeodetic& data)
 {
-	septentrio_gnss_driver::PosCovGeodeticPtr msg = boost::make_shared<septentrio_gnss_driver::PosCovGeodetic>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->mode = data.mode;
-	msg->error = data.error;
-	msg->cov_latlat = data.cov_latlat;
-	msg->cov_lonlon = data.cov_lonlon;
-	msg->cov_hgthgt = data.cov_hgthgt;
-	msg->cov_bb = data.cov_bb;
-	msg->cov_latlon = data.cov_latlon;
-	msg->cov_lathgt = data.cov_lathgt;
-	msg->cov_latb = data.cov_latb;
-	msg->cov_lonhgt = data.cov_lonhgt;
-	msg->cov_lonb = data.cov_lonb;
-	msg->cov_hb = data.cov_hb;
+	static MessagePool<septentrio_gnss_driver::PosCovGeodetic> pool;
+	septentrio_gnss_driver::PosCovGeodeticPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::PosCovGeodetic MsgType;
+	typedef PosCovGeodetic DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(mode), SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(cov_latlat),
+		SBF_MAPPED_FIELD(cov_lonlon), SBF_MAPPED_FIELD(cov_hgthgt), SBF_MAPPED_FIELD(cov_bb),
+		SBF_MAPPED_FIELD(cov_latlon), SBF_MAPPED_FIELD(cov_lathgt), SBF_MAPPED_FIELD(cov_latb),
+		SBF_MAPPED_FIELD(cov_lonhgt), SBF_MAPPED_FIELD(cov_lonb), SBF_MAPPED_FIELD(cov_hb));
 	return msg;
 }
 
 septentrio_gnss_driver::AttEulerPtr io_comm_rx::RxMessage::AttEulerCallback(AttEuler& data)
 {
-	septentrio_gnss_driver::AttEulerPtr msg = boost::make_shared<septentrio_gnss_driver::AttEuler>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->nr_sv = data.nr_sv;
-	msg->error = data.error;
-	msg->mode = data.mode;
-	msg->heading = data.heading;
-	msg->pitch = data.pitch;
-	msg->roll = data.roll;
-	msg->pitch_dot = data.pitch_dot;
-	msg->roll_dot = data.roll_dot;
-	msg->heading_dot = data.heading_dot;
+	static MessagePool<septentrio_gnss_driver::AttEuler> pool;
+	septentrio_gnss_driver::AttEulerPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::AttEuler MsgType;
+	typedef AttEuler DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(nr_sv), SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(mode),
+		SBF_MAPPED_FIELD(heading), SBF_MAPPED_FIELD(pitch), SBF_MAPPED_FIELD(roll),
+		SBF_MAPPED_FIELD(pitch_dot), SBF_MAPPED_FIELD(roll_dot), SBF_MAPPED_FIELD(heading_dot));
 	return msg;
 };
 
 septentrio_gnss_driver::AttCovEulerPtr io_comm_rx::RxMessage::AttCovEulerCallback(AttCovEuler& data)
 {
-	septentrio_gnss_driver::AttCovEulerPtr msg = boost::make_shared<septentrio_gnss_driver::AttCovEuler>();
-	msg->block_header.sync_1 = data.block_header.sync_1;
-	msg->block_header.sync_2 = data.block_header.sync_2;
-	msg->block_header.crc = data.block_header.crc;
-	msg->block_header.id = data.block_header.id;
-	msg->block_header.length = data.block_header.length;
-	msg->block_header.tow = data.tow;
-	msg->block_header.wnc = data.wnc;
-	msg->error = data.error;
-	msg->cov_headhead = data.cov_headhead;
-	msg->cov_pitchpitch = data.cov_pitchpitch;
-	msg->cov_rollroll = data.cov_rollroll;
-	msg->cov_headpitch = data.cov_headpitch;
-	msg->cov_headroll = data.cov_headroll;
-	msg->cov_pitchroll = data.cov_pitchroll;
+	static MessagePool<septentrio_gnss_driver::AttCovEuler> pool;
+	septentrio_gnss_driver::AttCovEulerPtr msg = pool.acquire();
+	typedef septentrio_gnss_driver::AttCovEuler MsgType;
+	typedef AttCovEuler DataType;
+	field_mapping::copyBlockHeader(*msg, data);
+	field_mapping::copyFields(*msg, data,
+		SBF_MAPPED_FIELD(error), SBF_MAPPED_FIELD(cov_headhead), SBF_MAPPED_FIELD(cov_pitchpitch),
+		SBF_MAPPED_FIELD(cov_rollroll), SBF_MAPPED_FIELD(cov_headpitch), SBF_MAPPED_FIELD(cov_headroll),
+		SBF_MAPPED_FIELD(cov_pitchroll));
 	return msg;
 };
 
@@ -281,7 +227,8 @@ septentrio_gnss_driver::AttCovEulerPtr io_comm_rx::RxMessage::AttCovEulerCallbac
  */
 geometry_msgs::PoseWithCovarianceStampedPtr io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
 {
-	geometry_msgs::PoseWithCovarianceStampedPtr msg = boost::make_shared<geometry_msgs::PoseWithCovarianceStamped>();
+	static MessagePool<geometry_msgs::PoseWithCovarianceStamped> pool;
+	geometry_msgs::PoseWithCovarianceStampedPtr msg = pool.acquire();
 	// Filling in the pose data
 	msg->pose.pose.orientation = parsing_utilities::convertEulerToQuaternion(static_cast<double>(last_atteuler_.heading), 
 		static_cast<double>(last_atteuler_.pitch), static_cast<double>(last_atteuler_.roll));
@@ -331,7 +278,8 @@ geometry_msgs::PoseWithCovarianceStampedPtr io_comm_rx::RxMessage::PoseWithCovar
 
 diagnostic_msgs::DiagnosticArrayPtr io_comm_rx::RxMessage::DiagnosticArrayCallback()
 {
-	diagnostic_msgs::DiagnosticArrayPtr msg = boost::make_shared<diagnostic_msgs::DiagnosticArray>();
+	static MessagePool<diagnostic_msgs::DiagnosticArray> pool;
+	diagnostic_msgs::DiagnosticArrayPtr msg = pool.acquire();
 	std::string serialnumber(last_receiversetup_.rx_serial_number);
 	diagnostic_msgs::DiagnosticStatusPtr gnss_status = boost::make_shared<diagnostic_msgs::DiagnosticStatus>();
 	// Constructing the "level of operation" field
@@ -418,6 +366,9 @@ diagnostic_msgs::DiagnosticArrayPtr io_comm_rx::RxMessage::DiagnosticArrayCallba
 	gnss_status->name = "GNSS";
 	gnss_status->message = "Quality Indicators (from 0 for low quality to 10 for high quality, 15 if unknown)";
 	msg->status.push_back(*gnss_status);
+	// The driver's own health travels alongside the receiver's: hot-path latency quantiles, the ring
+	// occupancy high-water mark and the CRC failure/resync counters, cf. the PipelineStats class.
+	msg->status.push_back(PipelineStats::pipelineStatus());
 	return msg;
 }
 
@@ -429,7 +380,8 @@ diagnostic_msgs::DiagnosticArrayPtr io_comm_rx::RxMessage::DiagnosticArrayCallba
  */
 sensor_msgs::NavSatFixPtr io_comm_rx::RxMessage::NavSatFixCallback()
 {
-	sensor_msgs::NavSatFixPtr msg = boost::make_shared<sensor_msgs::NavSatFix>();
+	static MessagePool<sensor_msgs::NavSatFix> pool;
+	sensor_msgs::NavSatFixPtr msg = pool.acquire();
 	uint16_t mask = 15; // We extract the first four bits using this mask.
 	uint16_t type_of_pvt = ((uint16_t) (last_pvtgeodetic_.mode)) & mask;
 	switch(type_of_pvt_map[type_of_pvt])
@@ -518,7 +470,8 @@ sensor_msgs::NavSatFixPtr io_comm_rx::RxMessage::NavSatFixCallback()
  */
 gps_common::GPSFixPtr io_comm_rx::RxMessage::GPSFixCallback()
 {
-	gps_common::GPSFixPtr msg = boost::make_shared<gps_common::GPSFix>();
+	static MessagePool<gps_common::GPSFix> pool;
+	gps_common::GPSFixPtr msg = pool.acquire();
 	
 	msg->status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_.nr_sv);
 	
@@ -762,53 +715,179 @@ gps_common::GPSFixPtr io_comm_rx::RxMessage::GPSFixCallback()
 	return msg;
 }
 	
-/// If the current time shall be employed, it is calculated via the time(NULL) function found in the <ctime> library
-/// At the time of writing the code (2020), the GPS time was ahead of UTC time by 18 (leap) seconds. Adapt 
-/// the g_leap_seconds ROSaic parameter accordingly as soon as the next leap second is inserted into the UTC time.
-ros::Time io_comm_rx::timestampSBF(uint32_t tow, bool use_gnss)
+/**
+ * The code, carrier and Doppler offset fields split across LSB and MSB parts in the sub-blocks are combined 
+ * into full-width fields here (the 3-bit code and 5-bit Doppler offset MSBs share one byte and are signed, 
+ * hence the manual sign extensions), while the signal-type-dependent steps - wavelength division for the 
+ * carrier phase, frequency-ratio scaling for the Doppler offsets - are left to the consumer, cf. the 
+ * comments in the message definition.
+ * The message is drawn from the pool without the usual wipe: every array is cleared (which keeps its grown 
+ * capacity) and refilled below, s.t. steady-state construction allocates nothing once the arrays have 
+ * grown to the receiver's channel count within the first few epochs.
+ */
+septentrio_gnss_driver::MeasEpochPtr io_comm_rx::RxMessage::MeasEpochCallback()
 {
-	if (use_gnss)
+	static MessagePool<septentrio_gnss_driver::MeasEpoch> pool;
+	septentrio_gnss_driver::MeasEpochPtr msg = pool.acquireDirty();
+	field_mapping::copyBlockHeader(*msg, last_measepoch_);
+	msg->common_flags = last_measepoch_.common_flags;
+	msg->cum_clk_jumps = last_measepoch_.cum_clk_jumps;
+	msg->rx_channel.clear();
+	msg->type.clear();
+	msg->sv_id.clear();
+	msg->code.clear();
+	msg->doppler.clear();
+	msg->carrier.clear();
+	msg->cn0.clear();
+	msg->lock_time.clear();
+	msg->obs_info.clear();
+	msg->type2_parent.clear();
+	msg->type2_type.clear();
+	msg->type2_code_offset.clear();
+	msg->type2_carrier.clear();
+	msg->type2_doppler_offset.clear();
+	msg->type2_cn0.clear();
+	msg->type2_lock_time.clear();
+	msg->type2_obs_info.clear();
+	uint8_t sb1_size = last_measepoch_.sb1_size;
+	uint8_t sb2_size = last_measepoch_.sb2_size;
+	uint8_t *sb_start = &last_measepoch_.data[0];
+	int32_t index = sb_start - &last_measepoch_.block_header.sync_1;
+	uint8_t type_mask = 15; // We extract the first four bits using this mask.
+	for (int32_t i = 0; i < static_cast<int32_t>(last_measepoch_.n); ++i)
 	{
-		uint16_t hh = (tow%(1000*60*60*24))/(60*60*1000);
-		uint16_t mm = ((tow%(1000*60*60*24))-hh*(60*60*1000))/(60*1000);
-		uint16_t ss = ((tow%(1000*60*60*24))-hh*(60*60*1000)-mm*(60*1000))/(1000);
-		uint16_t hs = ((tow%(1000*60*60*24))-hh*(60*60*1000)-mm*(60*1000)-ss*1000)/10; // hundredths of a second
-		if (ss >= g_leap_seconds)
+		// Define MeasEpochChannelType1 struct for the corresponding sub-block
+		MeasEpochChannelType1 *measepoch_channel_type1  = 
+			reinterpret_cast<MeasEpochChannelType1*>(&last_measepoch_.block_header.sync_1 + index);
+		msg->rx_channel.push_back(measepoch_channel_type1->rx_channel);
+		msg->type.push_back(measepoch_channel_type1->type);
+		msg->sv_id.push_back(measepoch_channel_type1->sv_id);
+		uint32_t code_msb = static_cast<uint32_t>(measepoch_channel_type1->misc & type_mask);
+		msg->code.push_back((static_cast<double>(code_msb) * 4294967296.0 + 
+			static_cast<double>(measepoch_channel_type1->code_lsb)) * 0.001);
+		msg->doppler.push_back(static_cast<float>(measepoch_channel_type1->doppler) * 0.0001f);
+		msg->carrier.push_back((static_cast<double>(measepoch_channel_type1->carrier_msb) * 65536.0 + 
+			static_cast<double>(measepoch_channel_type1->carrier_lsb)) * 0.001);
+		if (((measepoch_channel_type1->type & type_mask) == static_cast<uint8_t>(1)) || 
+			((measepoch_channel_type1->type & type_mask) == static_cast<uint8_t>(2)))
 		{
-			ss = ss - g_leap_seconds;
+			msg->cn0.push_back(static_cast<float>(measepoch_channel_type1->cn0) * 0.25f);
 		}
 		else
-		{	
-			if (mm >= 1)
+		{
+			msg->cn0.push_back(static_cast<float>(measepoch_channel_type1->cn0) * 0.25f + 10.0f);
+		}
+		msg->lock_time.push_back(measepoch_channel_type1->lock_time);
+		msg->obs_info.push_back(measepoch_channel_type1->obs_info);
+		index += sb1_size;
+		for (int32_t j = 0; j < static_cast<int32_t>(measepoch_channel_type1->n_type2); j++)
+		{
+			// Define MeasEpochChannelType2 struct for the corresponding sub-block
+			MeasEpochChannelType2 *measepoch_channel_type2  = 
+				reinterpret_cast<MeasEpochChannelType2*>(&last_measepoch_.block_header.sync_1 + index);
+			msg->type2_parent.push_back(static_cast<uint16_t>(i));
+			msg->type2_type.push_back(measepoch_channel_type2->type);
+			int32_t code_offset_msb = static_cast<int32_t>(measepoch_channel_type2->offsets_msb & 7);
+			if (code_offset_msb > 3) code_offset_msb -= 8;
+			int32_t doppler_offset_msb = static_cast<int32_t>((measepoch_channel_type2->offsets_msb >> 3) & 31);
+			if (doppler_offset_msb > 15) doppler_offset_msb -= 32;
+			msg->type2_code_offset.push_back((static_cast<double>(code_offset_msb) * 65536.0 + 
+				static_cast<double>(measepoch_channel_type2->code_offset_lsb)) * 0.001);
+			msg->type2_carrier.push_back((static_cast<double>(measepoch_channel_type2->carrier_msb) * 65536.0 + 
+				static_cast<double>(measepoch_channel_type2->carrier_lsb)) * 0.001);
+			msg->type2_doppler_offset.push_back((static_cast<float>(doppler_offset_msb) * 65536.0f + 
+				static_cast<float>(measepoch_channel_type2->doppler_offset_lsb)) * 0.0001f);
+			if (((measepoch_channel_type2->type & type_mask) == static_cast<uint8_t>(1)) || 
+				((measepoch_channel_type2->type & type_mask) == static_cast<uint8_t>(2)))
 			{
-				--mm;
-				ss = 60 - (g_leap_seconds - ss);
+				msg->type2_cn0.push_back(static_cast<float>(measepoch_channel_type2->cn0) * 0.25f);
 			}
 			else
 			{
-				if (hh >= 1)
-				{
-					--hh;
-					mm = 59;
-					ss = 60 - (g_leap_seconds - ss);
-				}
-				else
-				{
-					hh = 23;
-					mm = 59;
-					ss = 60 - (g_leap_seconds - ss);
-				}
+				msg->type2_cn0.push_back(static_cast<float>(measepoch_channel_type2->cn0) * 0.25f + 10.0f);
 			}
+			msg->type2_lock_time.push_back(measepoch_channel_type2->lock_time);
+			msg->type2_obs_info.push_back(measepoch_channel_type2->obs_info);
+			index += sb2_size;
+		}
+	}
+	return msg;
+}
+
+/**
+ * The sub-block walk is the very one the GPSFixCallback() method performs, only that all fields are kept 
+ * rather than merely elevations and azimuths. Cf. the remark above MeasEpochCallback() regarding the 
+ * allocation-free pool usage.
+ */
+septentrio_gnss_driver::ChannelStatusPtr io_comm_rx::RxMessage::ChannelStatusCallback()
+{
+	static MessagePool<septentrio_gnss_driver::ChannelStatus> pool;
+	septentrio_gnss_driver::ChannelStatusPtr msg = pool.acquireDirty();
+	field_mapping::copyBlockHeader(*msg, last_channelstatus_);
+	msg->sv_id.clear();
+	msg->freq_nr.clear();
+	msg->az_rise_set.clear();
+	msg->health_status.clear();
+	msg->elev.clear();
+	msg->channel.clear();
+	msg->state_parent.clear();
+	msg->antenna.clear();
+	msg->tracking_status.clear();
+	msg->pvt_status.clear();
+	msg->pvt_info.clear();
+	uint8_t sb1_size = last_channelstatus_.sb1_size;
+	uint8_t sb2_size = last_channelstatus_.sb2_size;
+	uint8_t *sb_start = &last_channelstatus_.data[0];
+	int32_t index = sb_start - &last_channelstatus_.block_header.sync_1;
+	for (int32_t i = 0; i < static_cast<int32_t>(last_channelstatus_.n); i++)
+	{
+		// Define ChannelSatInfo struct for the corresponding sub-block
+		ChannelSatInfo *channel_sat_info  = 
+			reinterpret_cast<ChannelSatInfo*>(&last_channelstatus_.block_header.sync_1 + index);
+		msg->sv_id.push_back(channel_sat_info->sv_id);
+		msg->freq_nr.push_back(channel_sat_info->freq_nr);
+		msg->az_rise_set.push_back(channel_sat_info->az_rise_set);
+		msg->health_status.push_back(channel_sat_info->health_status);
+		msg->elev.push_back(channel_sat_info->elev);
+		msg->channel.push_back(channel_sat_info->channel);
+		index += sb1_size;
+		for (int32_t j = 0; j < static_cast<int32_t>(channel_sat_info->n2); j++)
+		{
+			// Define ChannelStateInfo struct for the corresponding sub-block
+			ChannelStateInfo *channel_state_info  = 
+				reinterpret_cast<ChannelStateInfo*>(&last_channelstatus_.block_header.sync_1 + index);
+			msg->state_parent.push_back(static_cast<uint16_t>(i));
+			msg->antenna.push_back(channel_state_info->antenna);
+			msg->tracking_status.push_back(channel_state_info->tracking_status);
+			msg->pvt_status.push_back(channel_state_info->pvt_status);
+			msg->pvt_info.push_back(channel_state_info->pvt_info);
+			index += sb2_size;
 		}
-		boost::format fmt = boost::format("%02u%02u%02u.%02u") % hh % mm % ss % hs; 
-		std::string utc_string = fmt.str();
-		//ROS_DEBUG("UTC string is %s", utc_string.c_str());
-		double utc_double;
-		string_utilities::toDouble(utc_string, utc_double);
-		time_t unix_time_seconds = parsing_utilities::convertUTCtoUnix(utc_double); // This only deals with full seconds.
-		// The following works since there are two digits after the decimal point in the utc_double:
-		uint32_t unix_time_nanoseconds = (static_cast<uint32_t>(utc_double*100)%100)*10000000; 
-		ros::Time time_obj(unix_time_seconds, unix_time_nanoseconds);
+	}
+	return msg;
+}
+
+/// The GPS epoch (January 6, 1980) in Unix time is 315964800 seconds. At the time of writing the code 
+/// (2020), the GPS time was ahead of UTC time by 18 (leap) seconds. Adapt the g_leap_seconds ROSaic 
+/// parameter accordingly as soon as the next leap second is inserted into the UTC time.
+/// The cached variables are thread_local since the decode workers (cf. the DecodeWorkerPool class) may 
+/// stamp blocks of different types concurrently; the cache is tiny, hence one copy per worker is cheaper 
+/// than sharing one behind atomics.
+ros::Time io_comm_rx::timestampSBF(uint32_t tow, uint16_t wnc, bool use_gnss)
+{
+	if (use_gnss)
+	{
+		static thread_local uint32_t cached_wnc = 4294967295;
+		static thread_local uint32_t cached_leap_seconds = 4294967295;
+		static thread_local time_t week_epoch_unix = 0;
+		if (static_cast<uint32_t>(wnc) != cached_wnc || g_leap_seconds != cached_leap_seconds)
+		{
+			week_epoch_unix = static_cast<time_t>(315964800) + 
+				static_cast<time_t>(wnc) * 604800 - static_cast<time_t>(g_leap_seconds);
+			cached_wnc = static_cast<uint32_t>(wnc);
+			cached_leap_seconds = g_leap_seconds;
+		}
+		ros::Time time_obj(static_cast<uint32_t>(week_epoch_unix) + tow / 1000, (tow % 1000) * 1000000);
 		return time_obj;
 	}
 	else
@@ -817,6 +896,17 @@ ros::Time io_comm_rx::timestampSBF(uint32_t tow, bool use_gnss)
 	}
 }
 
+ros::Time io_comm_rx::RxMessage::messageStamp(uint32_t tow, uint16_t wnc)
+{
+	if (!g_use_gnss_time && !ingest_stamp_.isZero())
+	// The wire-arrival stamp captured by the AsyncManager class: it reflects when the frame entered the
+	// machine, as opposed to a clock sample taken once its decoding happened to complete.
+	{
+		return ingest_stamp_;
+	}
+	return timestampSBF(tow, wnc, g_use_gnss_time);
+}
+
 bool io_comm_rx::RxMessage::found()
 {
 	if (found_) return true;
@@ -831,20 +921,75 @@ bool io_comm_rx::RxMessage::found()
 	return true;
 }
   
-const uint8_t* io_comm_rx::RxMessage::search()
+//! Anonymous namespace for helpers local to this translation unit
+namespace
 {
-	if (found_) 
+	//! Does "data", with at least 2 readable bytes, start with one of the recognized sync pairs?
+	//! $@ starts an SBF block, $G/$P an NMEA sentence, $R a command reply and IP a connection descriptor.
+	inline bool isSyncPair(const uint8_t* data, bool read_cd)
 	{
-		next(); 
+		if (data[0] == SBF_SYNC_BYTE_1)
+		{
+			return (data[1] == SBF_SYNC_BYTE_2 || data[1] == NMEA_SYNC_BYTE_2_1 ||
+				data[1] == NMEA_SYNC_BYTE_2_2 || data[1] == RESPONSE_SYNC_BYTE_2);
+		}
+		return read_cd && data[0] == CONNECTION_DESCRIPTOR_BYTE_1 && data[1] == CONNECTION_DESCRIPTOR_BYTE_2;
 	}
-	// Search for message or a response header
-	for( ; count_ > 0; --count_, ++data_) 
+}
+
+const uint8_t* io_comm_rx::scanForSyncPair(const uint8_t* data, std::size_t count, bool read_cd)
+{
+	const uint8_t* end = data + count;
+#if defined(__SSE2__)
+	// 16 bytes at a time are compared against the candidate start bytes; only chunks containing a candidate
+	// at all drop into the byte-wise confirmation of the second sync byte.
+	while (static_cast<std::size_t>(end - data) >= 17) // 16 bytes to compare plus 1 for the second sync byte
 	{
-		if (this->isSBF() || this->isNMEA() || this->isResponse() || (g_read_cd && this->isConnectionDescriptor()))
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i hits = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(SBF_SYNC_BYTE_1));
+		if (read_cd)
 		{
-			break;
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(CONNECTION_DESCRIPTOR_BYTE_1)));
+		}
+		uint32_t candidates = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+		while (candidates != 0)
+		{
+			const uint8_t* candidate = data + __builtin_ctz(candidates);
+			if (isSyncPair(candidate, read_cd)) return candidate;
+			candidates &= candidates - 1; // Clears the lowest set bit
+		}
+		data += 16;
+	}
+#endif
+	// memchr (itself vectorized in any decent libc) locates the remaining candidates; with connection
+	// descriptors enabled the nearer of the two candidate bytes wins. The scan stops 1 byte short of the end
+	// since a sync pair's second byte must be readable too.
+	while (static_cast<std::size_t>(end - data) >= 2)
+	{
+		const uint8_t* candidate = static_cast<const uint8_t*>(memchr(data, SBF_SYNC_BYTE_1, end - data - 1));
+		if (read_cd)
+		{
+			const uint8_t* cd = static_cast<const uint8_t*>(memchr(data, CONNECTION_DESCRIPTOR_BYTE_1, end - data - 1));
+			if (candidate == NULL || (cd != NULL && cd < candidate)) candidate = cd;
 		}
+		if (candidate == NULL) return end;
+		if (isSyncPair(candidate, read_cd)) return candidate;
+		data = candidate + 1;
 	}
+	return end;
+}
+
+const uint8_t* io_comm_rx::RxMessage::search()
+{
+	if (found_)
+	{
+		next();
+	}
+	// Search for a message or a response header; the scanner lands either on the first sync pair or, if there
+	// is none, on the end of the buffer - just like the former byte-wise loop did.
+	const uint8_t* pos = scanForSyncPair(data_, count_, g_read_cd);
+	count_ -= pos - data_;
+	data_ = pos;
 	found_ = true;
 	return data_;
 }
@@ -1026,6 +1171,34 @@ bool io_comm_rx::RxMessage::isErrorMessage()
 	}
 }
 
+RxIDType io_comm_rx::RxMessage::messageNumber()
+{
+	if (this->isSBF())
+	{
+		// Defines bit mask..
+		// It is not as stated in the firmware: !first! three bits are for revision (not last 3), and rest for block number
+		uint16_t mask = 8191;
+		// Bitwise AND gives us all but first 3 bits set to zero, rest unchanged
+		return (*(reinterpret_cast<const uint16_t*>(data_+4))) & mask;
+	}
+	if (this->isNMEA())
+	{
+		// The sentence ID consists of the 5 characters following the leading $, e.g. GPGGA. Comparing those
+		// directly spares us the string construction and tokenizing of messageID().
+		if (count_ >= 6)
+		{
+			if (memcmp(data_ + 1, "GPGGA", 5) == 0) return RX_ID_GPGGA;
+			if (memcmp(data_ + 1, "GPRMC", 5) == 0) return RX_ID_GPRMC;
+			if (memcmp(data_ + 1, "GPGSA", 5) == 0) return RX_ID_GPGSA;
+			if (memcmp(data_ + 1, "GPGSV", 5) == 0) return RX_ID_GPGSV;
+			if (memcmp(data_ + 1, "GLGSV", 5) == 0) return RX_ID_GLGSV;
+			if (memcmp(data_ + 1, "GAGSV", 5) == 0) return RX_ID_GAGSV;
+			if (memcmp(data_ + 1, "GBGSV", 5) == 0) return RX_ID_GBGSV;
+		}
+	}
+	return RX_ID_UNKNOWN;
+}
+
 std::string io_comm_rx::RxMessage::messageID()
 {
 	if (this->isSBF())
@@ -1079,6 +1252,59 @@ uint16_t io_comm_rx::RxMessage::getBlockLength()
 	}
 }
 
+uint32_t io_comm_rx::RxMessage::getTow()
+{
+	// The time stamp field directly follows the 8-byte block header in every SBF block
+	return *(reinterpret_cast<const uint32_t*>(data_ + 8));
+}
+
+uint16_t io_comm_rx::RxMessage::getWnc()
+{
+	return *(reinterpret_cast<const uint16_t*>(data_ + 12));
+}
+
+bool io_comm_rx::RxMessage::checkCrc()
+{
+	crc_check_ = isValid(data_);
+	if (!crc_check_)
+	{
+		PipelineStats::countCrcFailure();
+	}
+	return crc_check_;
+}
+
+void io_comm_rx::RxMessage::publishRawBlock(RxIDType message_key)
+{
+	if (!this->isSBF()) return; // The passthrough is defined for SBF blocks only
+	// If the CRC check is unsuccessful, throw an error message.
+	if (!checkCrc())
+	{
+		throw std::runtime_error("CRC Check returned False. Not a valid data block, perhaps noisy. Ignore..");
+	}
+	static MessagePool<septentrio_gnss_driver::RawBlock> pool;
+	septentrio_gnss_driver::RawBlockPtr msg = pool.acquire();
+	msg->header.frame_id = g_frame_id;
+	uint32_t tow = *(reinterpret_cast<const uint32_t *>(data_ + 8));
+	ros::Time time_obj;
+	time_obj = messageStamp(tow, *(reinterpret_cast<const uint16_t *>(data_ + 12)));
+	msg->header.stamp.sec = time_obj.sec;
+	msg->header.stamp.nsec = time_obj.nsec;
+	// The block header is lifted out of the raw bytes, s.t. subscribers can filter on the ID (or pair
+	// blocks of one epoch via TOW/WNc) without re-parsing; note that the ID is the plain block number,
+	// exactly as in the other SBF-echoing ROS messages.
+	msg->block_header.sync_1 = data_[0];
+	msg->block_header.sync_2 = data_[1];
+	msg->block_header.crc = *(reinterpret_cast<const uint16_t *>(data_ + 2));
+	msg->block_header.id = message_key;
+	msg->block_header.length = this->getBlockLength();
+	msg->block_header.tow = tow;
+	msg->block_header.wnc = *(reinterpret_cast<const uint16_t *>(data_ + 12));
+	msg->data.assign(data_, data_ + this->getBlockLength());
+	// All raw blocks of a stream share one publisher (and hence one topic), filed under the synthetic
+	// RX_ID_RAWBLOCK key s.t. a block ID whose decoded counterpart is enabled too keeps its own slot.
+	PublisherRegistry::publish(stream_id_, RX_ID_RAWBLOCK, topic_prefix_, "/rawblock", *msg);
+}
+
 /**
  * This method won't make data_ jump to the next message if the current one is an NMEA message or a command reply. In that case, search() will
  * check the bytes one by one for the new message's sync bytes ($P, $G or $R).
@@ -1107,6 +1333,9 @@ void io_comm_rx::RxMessage::next()
 			}
 			else
 			{
+				// The block's announced length cannot be trusted, the scanner has to hunt for the next
+				// sync pair byte-wise - worth counting, streaks of these betray a corrupted stream.
+				PipelineStats::countResync();
 				jump_size = static_cast<std::size_t>(1);
 			}
 		}
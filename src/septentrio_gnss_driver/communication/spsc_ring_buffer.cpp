@@ -0,0 +1,186 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/spsc_ring_buffer.hpp>
+// For the overflow counters surfaced through the diagnostics path
+#include <septentrio_gnss_driver/communication/pipeline_stats.hpp>
+
+/**
+ * @file spsc_ring_buffer.cpp
+ * @brief Defines a lock-free single-producer single-consumer ring buffer for the I/O-thread-to-parser-thread handover
+ * @date 14/01/26
+ */
+
+SPSCRingBuffer::SPSCRingBuffer(std::size_t capacity): head_(0), tail_(0), overflowed_(false)
+{
+	// Rounding up to the next power of two s.t. the modulo operation reduces to a bit mask
+	capacity_ = 1;
+	while (capacity_ < capacity) capacity_ <<= 1;
+	mask_ = capacity_ - 1;
+	data_ = new uint8_t[capacity_];
+}
+
+//! The destructor frees memory (first line) and points the dangling pointer to NULL (second line).
+SPSCRingBuffer::~SPSCRingBuffer()
+{
+	delete [] data_;
+	data_ = NULL;
+}
+
+std::size_t SPSCRingBuffer::write(const uint8_t *data, std::size_t bytes)
+{
+	if (bytes == 0) return 0;
+
+	// A chunk larger than the whole ring (only possible with a pathologically small configured
+	// capacity) keeps its newest capacity_ bytes, consistent with the drop-oldest policy below.
+	std::size_t dropped = 0;
+	if (bytes > capacity_)
+	{
+		dropped = bytes - capacity_;
+		data += dropped;
+		bytes = capacity_;
+	}
+
+	std::size_t head = head_.load(std::memory_order_relaxed);
+	// The acquire pairs with the consumer's release in consumeTo()/read(): released bytes may only be
+	// overwritten below once the consumer is demonstrably done reading them.
+	std::size_t tail = tail_.load(std::memory_order_acquire);
+	if (capacity_ - (head - tail) < bytes)
+	{
+		// Drop-oldest overflow policy, cf. the class description: the oldest unread bytes are evicted
+		// (the tail is advanced past them) until the incoming chunk fits, s.t. the newest bytes survive
+		// intact and the parser - once notified via the overflow flag - resumes cleanly at the next sync
+		// pair. The compare-and-swap loop accounts for the consumer concurrently releasing bytes, in
+		// which case less (or nothing) needs evicting.
+		while (capacity_ - (head - tail) < bytes)
+		{
+			std::size_t overshoot = bytes - (capacity_ - (head - tail));
+			if (tail_.compare_exchange_weak(tail, tail + overshoot, std::memory_order_release,
+				std::memory_order_acquire))
+			{
+				dropped += overshoot;
+				tail += overshoot;
+			}
+		}
+		overflowed_.store(true, std::memory_order_release);
+	}
+	if (dropped > 0)
+	{
+		io_comm_rx::PipelineStats::countOverflow(dropped);
+		// Throttled: under sustained overload this branch fires on every write, and the logging itself
+		// must not make the backlog worse.
+		ROS_WARN_THROTTLE(1.0,
+			"The parser thread did not keep up: SPSC ring buffer overflow, evicted the oldest %li unread bytes to admit the newest ones!",
+			dropped);
+	}
+
+	std::size_t offset = head & mask_;
+	// Writes in a single step
+	if (bytes <= capacity_ - offset)
+	{
+		memcpy(data_ + offset, data, bytes);
+	}
+	// Writes in two steps. Here the circular nature comes to the surface
+	else
+	{
+		std::size_t size_1 = capacity_ - offset;
+		memcpy(data_ + offset, data, size_1);
+		memcpy(data_, data + size_1, bytes - size_1);
+	}
+	// The release store publishes the bytes written above to the consumer.
+	head_.store(head + bytes, std::memory_order_release);
+	return bytes;
+}
+
+std::size_t SPSCRingBuffer::contiguousFree() const
+{
+	std::size_t head = head_.load(std::memory_order_relaxed);
+	std::size_t tail = tail_.load(std::memory_order_acquire);
+	std::size_t free_bytes = capacity_ - (head - tail);
+	return std::min(free_bytes, capacity_ - (head & mask_));
+}
+
+void SPSCRingBuffer::commitWrite(std::size_t bytes)
+{
+	// The release store publishes the bytes deposited at writePtr() to the consumer.
+	head_.store(head_.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+}
+
+std::size_t SPSCRingBuffer::contiguousSize() const
+{
+	std::size_t tail = tail_.load(std::memory_order_relaxed);
+	std::size_t head = head_.load(std::memory_order_acquire);
+	return std::min(head - tail, capacity_ - (tail & mask_));
+}
+
+void SPSCRingBuffer::advanceTailTo(std::size_t target)
+{
+	// The release frees up the bytes below "target" for reuse by the producer. With the drop-oldest
+	// overflow policy the producer may race this advance with an eviction of its own (cf. write()),
+	// hence the compare-and-swap loop: whichever of the two got further simply stands, an advance to
+	// an offset an eviction has already passed is a no-op. Note that "target" never exceeds the head,
+	// being derived from a readable-bytes count the consumer sampled beforehand.
+	std::size_t tail = tail_.load(std::memory_order_relaxed);
+	while (tail < target && !tail_.compare_exchange_weak(tail, target, std::memory_order_release,
+		std::memory_order_relaxed)) {}
+}
+
+void SPSCRingBuffer::consumeTo(std::size_t end_offset)
+{
+	advanceTailTo(end_offset);
+}
+
+std::size_t SPSCRingBuffer::read(uint8_t *data, std::size_t bytes)
+{
+	if (bytes == 0) return 0;
+
+	std::size_t tail = tail_.load(std::memory_order_relaxed);
+	std::size_t head = head_.load(std::memory_order_acquire);
+	std::size_t bytes_to_read = std::min(bytes, head - tail);
+	if (bytes_to_read == 0) return 0;
+
+	std::size_t offset = tail & mask_;
+	// Read in a single step
+	if (bytes_to_read <= capacity_ - offset)
+	{
+		memcpy(data, data_ + offset, bytes_to_read);
+	}
+	// Read in two steps
+	else
+	{
+		std::size_t size_1 = capacity_ - offset;
+		memcpy(data, data_ + offset, size_1);
+		memcpy(data + size_1, data_, bytes_to_read - size_1);
+	}
+	// Frees up the bytes read above for reuse by the producer; a concurrent eviction may have advanced
+	// past them already, cf. advanceTailTo().
+	advanceTailTo(tail + bytes_to_read);
+	return bytes_to_read;
+}
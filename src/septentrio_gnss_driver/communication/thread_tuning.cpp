@@ -0,0 +1,113 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/thread_tuning.hpp>
+// ROS includes
+#include <ros/ros.h>
+// C++ library includes
+#include <cstdio>
+#include <cstring>
+#if defined(__linux__)
+// For pthread_setname_np, pthread_setaffinity_np and pthread_setschedparam
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @file thread_tuning.cpp
+ * @date 01/09/26
+ * @brief Defines a class ThreadTuning applying names, CPU affinity and real-time priority to driver threads
+ */
+
+int io_comm_rx::ThreadTuning::io_cpu_ = -1;
+int io_comm_rx::ThreadTuning::parse_cpu_ = -1;
+int io_comm_rx::ThreadTuning::rt_priority_ = 0;
+
+void io_comm_rx::ThreadTuning::configure(int io_cpu, int parse_cpu, int rt_priority)
+{
+	io_cpu_ = io_cpu;
+	parse_cpu_ = parse_cpu;
+	rt_priority_ = rt_priority;
+}
+
+void io_comm_rx::ThreadTuning::applyIO(boost::thread& thread, std::size_t index)
+{
+	// Thread names are capped at 15 characters by the kernel; the index distinguishes the threads of
+	// the shared I/O pool (cf. Comm_IO::startIOThreadPool()) from one another and from a stream's
+	// dedicated I/O thread, which goes by the plain name.
+	char name[16];
+	if (index == 0) snprintf(name, sizeof(name), "rosaic_io");
+	else snprintf(name, sizeof(name), "rosaic_io%li", index);
+	apply(thread, name, io_cpu_, rt_priority_);
+}
+
+void io_comm_rx::ThreadTuning::applyParser(boost::thread& thread)
+{
+	apply(thread, "rosaic_parse", parse_cpu_, rt_priority_);
+}
+
+void io_comm_rx::ThreadTuning::apply(boost::thread& thread, const char* name, int cpu, int rt_priority)
+{
+#if defined(__linux__)
+	// All three tweaks go through the thread's native handle, s.t. they can be applied right after the
+	// spawn, from the spawning thread, without cooperation of the thread's own body.
+	pthread_t handle = thread.native_handle();
+	pthread_setname_np(handle, name);
+	if (cpu >= 0)
+	{
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+		int result = pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set);
+		if (result != 0)
+		{
+			ROS_WARN("Could not pin thread %s to CPU %i: %s", name, cpu, strerror(result));
+		}
+	}
+	if (rt_priority > 0)
+	{
+		struct sched_param scheduling;
+		scheduling.sched_priority = rt_priority;
+		int result = pthread_setschedparam(handle, SCHED_FIFO, &scheduling);
+		if (result != 0)
+		{
+			// The classic failure mode: the node lacks CAP_SYS_NICE and the user's rtprio limit
+			// (cf. /etc/security/limits.conf) is 0. The driver keeps running under default scheduling.
+			ROS_WARN("Could not give thread %s SCHED_FIFO priority %i: %s", name, rt_priority,
+				strerror(result));
+		}
+	}
+#else
+	(void)thread;
+	(void)name;
+	(void)cpu;
+	(void)rt_priority;
+#endif
+}
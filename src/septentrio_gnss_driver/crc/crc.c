@@ -37,29 +37,73 @@
  */
 
 /**
- * Note that a void pointer is a pointer that has no associated data type with it. A void pointer can 
+ * Slice-by-8 look-up tables, derived from CRC_LOOK_UP at first use: SLICE_TABLES[0] equals CRC_LOOK_UP, and
+ * SLICE_TABLES[k][i] is the CRC of byte i followed by k zero bytes. They let compute16CCITT consume 8 message
+ * bytes per iteration instead of 1, cf. below.
+ */
+static uint16_t SLICE_TABLES[8][256];
+static bool slice_tables_ready = false;
+
+static void initSliceTables(void)
+{
+	uint32_t i, k;
+	for (i = 0; i < 256; i++)
+	{
+		SLICE_TABLES[0][i] = CRC_LOOK_UP[i];
+	}
+	for (k = 1; k < 8; k++)
+	{
+		for (i = 0; i < 256; i++)
+		{
+			// Appending one zero byte to the message behind table entry [k-1][i] yields entry [k][i]
+			uint16_t crc = SLICE_TABLES[k-1][i];
+			SLICE_TABLES[k][i] = (uint16_t) ((crc << 8) ^ CRC_LOOK_UP[crc >> 8]);
+		}
+	}
+	// The tables' contents never change once written, hence a second thread racing into this initialization
+	// would merely redo the identical (idempotent) writes.
+	slice_tables_ready = true;
+}
+
+/**
+ * Note that a void pointer is a pointer that has no associated data type with it. A void pointer can
  * hold address of any type and can be typcasted to any type.
  */
 uint16_t compute16CCITT (const void *buf, size_t buf_length) // The CRC we choose is 2 bytes, remember, hence uint16_t..
 {
-	uint32_t  i; 
+	size_t    i;
 	uint16_t  crc = 0; // Seed is 0, as suggested by the firmware, will compute CRC in the forward direction..
-	
-	const uint8_t  *buf8 = (const uint8_t *) buf; 
-	for (i=0; i<buf_length; i++) 
+
+	const uint8_t  *buf8 = (const uint8_t *) buf;
+	if (buf_length >= 16)
+	{
+		// Slice-by-8: since the CRC is linear, the 16-bit running state can be folded into the first two of
+		// the next 8 message bytes, whereupon the 8 bytes contribute one independent table look-up each. The
+		// 8 look-ups hit 8 different tables and thus pipeline well, which is what makes large blocks (e.g.
+		// MeasEpoch at 100 Hz) so much cheaper to validate than with the byte-at-a-time loop below.
+		if (!slice_tables_ready)
+		{
+			initSliceTables();
+		}
+		while (buf_length >= 8)
+		{
+			crc = SLICE_TABLES[7][buf8[0] ^ (crc >> 8)] ^
+			      SLICE_TABLES[6][buf8[1] ^ (crc & 0xFF)] ^
+			      SLICE_TABLES[5][buf8[2]] ^
+			      SLICE_TABLES[4][buf8[3]] ^
+			      SLICE_TABLES[3][buf8[4]] ^
+			      SLICE_TABLES[2][buf8[5]] ^
+			      SLICE_TABLES[1][buf8[6]] ^
+			      SLICE_TABLES[0][buf8[7]];
+			buf8 += 8;
+			buf_length -= 8;
+		}
+	}
+	// Byte-at-a-time for short buffers and the tail of long ones.
+	// CRC_LOOK_UP is constructed from the truncated polynomial (divisor).
+	for (i=0; i<buf_length; i++)
 	{
-		crc = (crc << 8) ^ CRC_LOOK_UP[ (crc >> 8) ^ buf8[i] ]; 
-	// The ^ (bitwise XOR) in C or C++ takes two numbers as operands and does XOR on every bit of two numbers. 
-	// The result of XOR is 1 if the two bits are different. 
-	// The << (left shift) in C or C++ takes two numbers, left shifts the bits of the first operand, 
-	// the second operand decides the number of places to shift. 
-	// The >> (right shift) in C or C++ takes two numbers, right shifts the bits of the first operand, 
-	// the second operand decides the number of places to shift; you can just loose the smallest values if big-endian.
-	// The left shift and right shift operators should not be used for negative numbers.
-	// The left-shift and right-shift operators are equivalent to multiplication and division by 2 respectively, 
-	// hence only rightshift is non-exact (remainder is not retained).
-	// CRC_LOOK_UP is constructed from truncated polynomial (divisor).
-	// The above implements a kind of CRC 32 algorithm: efficient, fast.
+		crc = (crc << 8) ^ CRC_LOOK_UP[ (crc >> 8) ^ buf8[i] ];
 	}
 
 	return crc;
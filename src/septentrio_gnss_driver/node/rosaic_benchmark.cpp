@@ -0,0 +1,279 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/callback_handlers.hpp>
+// Boost includes
+#include <boost/chrono.hpp>
+// C++ library includes
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+// POSIX includes for replaying the capture files via mmap
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+/**
+ * @file rosaic_benchmark.cpp
+ * @date 01/09/26
+ * @brief Decode-throughput benchmark replaying recorded SBF/NMEA streams through the driver's pipeline
+ *
+ * Usage: rosrun septentrio_gnss_driver septentrio_gnss_driver_benchmark <capture.sbf> [<capture2.sbf> ..]
+ *
+ * The given capture files (e.g. recorded via the raw_capture ROS parameters, or any logged SBF/NMEA
+ * stream) are pumped through CallbackHandlers::readCallback() and the RxMessage decode switch exactly as
+ * live receiver bytes would be, with ROS publishing stubbed out, s.t. the reported numbers isolate the
+ * driver's own decode cost. No ROS master is needed; the tool prints blocks/sec, bytes/sec and the
+ * per-message-type decode cost, and is meant to be run in CI against fixed capture fixtures to catch
+ * decode-throughput regressions before a rover catches them in the field by dropping bytes.
+ */
+
+//! Decode count per numeric message ID, filled by the profiler hook during the replay
+static uint64_t block_counts[RX_ID_TABLE_SIZE];
+//! Accumulated decode nanoseconds per numeric message ID, filled alongside block_counts
+static uint64_t block_nanoseconds[RX_ID_TABLE_SIZE];
+
+//! The profiler hook handed to CallbackHandlers::setDecodeProfiler(), called once per handled message
+static void recordDecode(RxIDType message_key, int64_t nanoseconds)
+{
+	++block_counts[message_key];
+	block_nanoseconds[message_key] += static_cast<uint64_t>(nanoseconds);
+}
+
+//! Human-readable name of the given numeric message ID for the report, the number itself if unknown
+static std::string messageName(RxIDType key)
+{
+	switch (key)
+	{
+		case 4001: return "DOP";
+		case 4006: return "PVTCartesian";
+		case 4007: return "PVTGeodetic";
+		case 4013: return "ChannelStatus";
+		case 4014: return "ReceiverStatus";
+		case 4027: return "MeasEpoch";
+		case 4082: return "QualityInd";
+		case 5902: return "ReceiverSetup";
+		case 5905: return "PosCovCartesian";
+		case 5906: return "PosCovGeodetic";
+		case 5908: return "VelCovGeodetic";
+		case 5938: return "AttEuler";
+		case 5939: return "AttCovEuler";
+		case RX_ID_GPGGA: return "GPGGA";
+		case RX_ID_GPRMC: return "GPRMC";
+		case RX_ID_GPGSA: return "GPGSA";
+		case RX_ID_GPGSV: return "GPGSV";
+		case RX_ID_GLGSV: return "GLGSV";
+		case RX_ID_GAGSV: return "GAGSV";
+		case RX_ID_GBGSV: return "GBGSV";
+		default: return std::to_string(static_cast<unsigned int>(key));
+	}
+}
+
+/**
+ * @brief Replays one capture file through readCallback(), mirroring Comm_IO::initializeSBFFileReader()
+ * @param[in] handlers The callback handlers the file's chunks are handed to
+ * @param[in] file_path Path of the capture file
+ * @param[out] total_bytes Accumulates the number of bytes replayed
+ * @return True in case the file could be opened and mapped, false otherwise
+ */
+static bool replayFile(io_comm_rx::CallbackHandlers& handlers, const std::string& file_path,
+	uint64_t& total_bytes)
+{
+	int fd = open(file_path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		std::fprintf(stderr, "Could not open capture file %s: %s\n", file_path.c_str(), strerror(errno));
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0)
+	{
+		std::fprintf(stderr, "Could not stat capture file %s or file is empty.\n", file_path.c_str());
+		close(fd);
+		return false;
+	}
+	std::size_t file_size = static_cast<std::size_t>(file_stat.st_size);
+	const uint8_t* data = static_cast<const uint8_t*>(mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		std::fprintf(stderr, "Could not mmap capture file %s: %s\n", file_path.c_str(), strerror(errno));
+		return false;
+	}
+	madvise(const_cast<uint8_t*>(data), file_size, MADV_SEQUENTIAL);
+	// The same chunking contract as the file:// playback mode of the node: readCallback() throws the
+	// offset of the first not-yet-parsable byte whenever a message straddles the chunk boundary, and the
+	// next chunk restarts right there.
+	const std::size_t CHUNK_SIZE = 1048576;
+	std::size_t offset = 0;
+	while (offset < file_size)
+	{
+		std::size_t chunk = std::min(CHUNK_SIZE, file_size - offset);
+		try
+		{
+			handlers.readCallback(data + offset, chunk);
+			offset += chunk;
+		}
+		catch (std::size_t& parsing_failed_here)
+		{
+			if (parsing_failed_here == 0)
+			{
+				std::fprintf(stderr, "Capture file %s ends mid-message; stopping its replay here.\n",
+					file_path.c_str());
+				break;
+			}
+			offset += parsing_failed_here;
+		}
+	}
+	total_bytes += offset;
+	munmap(const_cast<uint8_t*>(data), file_size);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <capture.sbf> [<capture2.sbf> ..]\n", argv[0]);
+		return 1;
+	}
+	// roscpp's clock must be up for the header stamps the decode switch constructs, yet no node handle
+	// (and hence no ROS master) is needed since publishing is stubbed out below.
+	ros::Time::init();
+	// Decode everything the node can decode, s.t. the benchmark covers the full pipeline: timestamps from
+	// the TOW fields (making the replay deterministic), every publish flag switched on.
+	g_use_gnss_time = true;
+	g_frame_id = "gnss";
+	g_leap_seconds = 18;
+	g_publish_gpst = true;
+	g_publish_navsatfix = true;
+	g_publish_gpsfix = true;
+	g_publish_pose = true;
+	g_publish_diagnostics = true;
+	g_publish_measepoch = true;
+	g_publish_channelstatus = true;
+	g_read_cd = false;
+	io_comm_rx::PublisherRegistry::stub();
+	// Insert the same handlers ROSaicNode::defineMessages() would, all publish-only
+	io_comm_rx::CallbackHandlers handlers;
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgga>(RX_ID_GPGGA, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gprmc>(RX_ID_GPRMC, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsa>(RX_ID_GPGSA, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GPGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GLGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GAGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GBGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PVTCartesian>(4006, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PVTGeodetic>(4007, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PosCovCartesian>(5905, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PosCovGeodetic>(5906, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::AttEuler>(5938, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::AttCovEuler>(5939, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(RX_ID_GPST, true);
+	handlers.callbackmap_ = handlers.insert<sensor_msgs::NavSatFix>(RX_ID_NAVSATFIX, true);
+	handlers.callbackmap_ = handlers.insert<gps_common::GPSFix>(RX_ID_GPSFIX, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(4013, true); // ChannelStatus block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4027, true); // MeasEpoch block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4001, true); // DOP block
+	handlers.callbackmap_ = handlers.insert<int32_t>(5908, true); // VelCovGeodetic block
+	handlers.callbackmap_ = handlers.insert<geometry_msgs::PoseWithCovarianceStamped>(RX_ID_POSEWITHCOVARIANCESTAMPED, true);
+	handlers.callbackmap_ = handlers.insert<diagnostic_msgs::DiagnosticArray>(RX_ID_DIAGNOSTICARRAY, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(4014, true); // ReceiverStatus block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4082, true); // QualityInd block
+	handlers.callbackmap_ = handlers.insert<int32_t>(5902, true); // ReceiverSetup block
+	io_comm_rx::CallbackHandlers::setDecodeProfiler(&recordDecode);
+
+	uint64_t total_bytes = 0;
+	bool all_files_replayed = true;
+	boost::chrono::steady_clock::time_point replay_start = boost::chrono::steady_clock::now();
+	for (int arg = 1; arg < argc; ++arg)
+	{
+		all_files_replayed &= replayFile(handlers, argv[arg], total_bytes);
+	}
+	double elapsed_seconds = boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+		boost::chrono::steady_clock::now() - replay_start).count() / 1e9;
+
+	uint64_t total_blocks = 0;
+	std::vector<RxIDType> decoded_keys;
+	for (std::size_t key = 0; key < RX_ID_TABLE_SIZE; ++key)
+	{
+		if (block_counts[key] == 0) continue;
+		total_blocks += block_counts[key];
+		decoded_keys.push_back(static_cast<RxIDType>(key));
+	}
+	// Most expensive message type first, s.t. a regression's culprit tops the report
+	std::sort(decoded_keys.begin(), decoded_keys.end(),
+		[](RxIDType a, RxIDType b) { return block_nanoseconds[a] > block_nanoseconds[b]; });
+
+	std::printf("Replayed %lu bytes holding %lu blocks/sentences in %.3f s:\n",
+		static_cast<unsigned long>(total_bytes), static_cast<unsigned long>(total_blocks), elapsed_seconds);
+	std::printf("  %.1f MB/sec, %.0f blocks/sec\n\n", total_bytes / elapsed_seconds / 1e6,
+		total_blocks / elapsed_seconds);
+	std::printf("%-20s %12s %12s %14s\n", "Message type", "Count", "Total ms", "Mean us/block");
+	for (std::size_t entry = 0; entry < decoded_keys.size(); ++entry)
+	{
+		RxIDType key = decoded_keys[entry];
+		std::printf("%-20s %12lu %12.3f %14.3f\n", messageName(key).c_str(),
+			static_cast<unsigned long>(block_counts[key]), block_nanoseconds[key] / 1e6,
+			block_nanoseconds[key] / 1e3 / block_counts[key]);
+	}
+	return all_files_replayed ? 0 : 1;
+}
+
+// The linked translation units reference the driver's globals, which the node's TU defines right next to
+// its own main(); the benchmark, carrying its own main() instead, hence supplies its own definitions.
+// Cf. rosaic_node.cpp for the documentation of each.
+bool g_use_gnss_time;
+bool g_publish_gpst;
+bool g_publish_navsatfix;
+bool g_publish_gpsfix;
+bool g_publish_pose;
+bool g_publish_diagnostics;
+bool g_publish_measepoch;
+bool g_publish_channelstatus;
+std::string g_frame_id;
+uint32_t g_leap_seconds;
+boost::mutex g_response_mutex;
+bool g_response_received;
+boost::condition_variable g_response_condition;
+uint32_t g_response_count;
+std::deque<std::string> g_outstanding_commands;
+std::string g_response_error;
+boost::mutex g_cd_mutex;
+bool g_cd_received;
+boost::condition_variable g_cd_condition;
+bool g_read_cd;
+std::string g_rx_tcp_port;
+uint32_t g_cd_count;
+boost::shared_ptr<ros::NodeHandle> g_nh;
+const uint32_t g_ROS_QUEUE_SIZE = 1;
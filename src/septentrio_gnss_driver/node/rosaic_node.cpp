@@ -29,6 +29,9 @@
 // ****************************************************************************
 
 #include <septentrio_gnss_driver/node/rosaic_node.hpp>
+// C++ library includes for the configuration fingerprint
+#include <fstream>
+#include <functional>
 
 /**
  * @file rosaic_node.cpp
@@ -51,14 +54,33 @@ rosaic_node::ROSaicNode::ROSaicNode()
 	// storing the callback handlers and publishes ROS messages
     defineMessages();
 	
-	// Sends commands to the Rx regarding which SBF/NMEA messages it should output and sets all 
-	// its necessary corrections-related parameters
-	boost::mutex::scoped_lock lock(connection_mutex_);
-	connection_condition_.wait(lock, [this](){return connected_;});
-	configureRx();
-	
-	// Since we already have a ros::Spin() elsewhere, we use waitForShutdown() here
-	ros::waitForShutdown();	
+	if (sbf_file_playback_)
+	{
+		// There is no receiver to connect to or configure in playback mode: the logged file is replayed
+		// through the decode pipeline at full CPU speed now that the handlers are in place.
+		IO.initializeSBFFileReader(sbf_file_path_);
+	}
+	else if (udp_)
+	{
+		// A UDP stream is ingest-only: a multicast group (or wildcard listener) offers no command
+		// channel to run configureRx() over, hence the receiver itself must already be configured to
+		// stream the wanted SBF/NMEA messages to the given port.
+		boost::mutex::scoped_lock lock(connection_mutex_);
+		connection_condition_.wait(lock, [this](){return connected_;});
+		ROS_INFO("UDP streams are ingest-only, skipping the receiver configuration..");
+	}
+	else
+	{
+		// Sends commands to the Rx regarding which SBF/NMEA messages it should output and sets all
+		// its necessary corrections-related parameters
+		boost::mutex::scoped_lock lock(connection_mutex_);
+		connection_condition_.wait(lock, [this](){return connected_;});
+		configureRx();
+	}
+
+	// The constructor returns once the receiver is connected and configured; spinning and waiting for
+	// shutdown is the business of the hosting entry point, i.e. main() when running standalone and the
+	// nodelet manager when running as a nodelet (cf. the ROSaicNodelet class).
 	ROS_DEBUG("Leaving ROSaicNode() constructor..");
 }
 
@@ -82,24 +104,23 @@ void rosaic_node::ROSaicNode::configureRx()
 	g_cd_condition.wait(lock_cd, [](){return g_cd_received;}); 
 	g_cd_received = false;
 	
-	// Turning off all current SBF/NMEA output 
-	IO.send("sso, all, none, none, off \x0D");
-	g_response_condition.wait(lock, [](){return g_response_received;});
-	g_response_received = false;
-	IO.send("sno, all, none, none, off \x0D");
-	g_response_condition.wait(lock, [](){return g_response_received;});
-	g_response_received = false;
-	
-	// Setting the datum to be used by the Rx (not the NMEA output though, which only provides MSL and undulation 
+	// The commands are first collected in order, then - depending on the pipelined_configuration ROS
+	// parameter - either streamed out back-to-back with the responses matched asynchronously (cf. below),
+	// or sent one-by-one with a wait for each "$R" response in between, as was always the case.
+	std::vector<std::string> commands;
+
+	// Turning off all current SBF/NMEA output
+	commands.push_back("sso, all, none, none, off \x0D");
+	commands.push_back("sno, all, none, none, off \x0D");
+
+	// Setting the datum to be used by the Rx (not the NMEA output though, which only provides MSL and undulation
 	// (by default with respect to WGS84), but not ellipsoidal height)
 	{
 		std::stringstream ss;
-		ss << "sgd, " << datum_ << "\x0D"; 
-		IO.send(ss.str());
+		ss << "sgd, " << datum_ << "\x0D";
+		commands.push_back(ss.str());
 	}
-	g_response_condition.wait(lock, [](){return g_response_received;});
-	g_response_received = false;
-	
+
 	// Setting SBF/NMEA output of Rx
 	unsigned stream = 1;
 	boost::smatch match;
@@ -132,10 +153,8 @@ void rosaic_node::ROSaicNode::configureRx()
 		
 		ss << "sno, Stream" << std::to_string(stream) << ", " << rx_port << ", GGA, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D"; 
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_gprmc_ == true)
 	{
@@ -143,10 +162,8 @@ void rosaic_node::ROSaicNode::configureRx()
 		
 		ss << "sno, Stream" << std::to_string(stream) << ", " << rx_port << ", RMC, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D"; 
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_gpgsa_ == true)
 	{
@@ -154,10 +171,8 @@ void rosaic_node::ROSaicNode::configureRx()
 		
 		ss << "sno, Stream" << std::to_string(stream) << ", " << rx_port << ", GSA, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D"; 
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_gpgsv_ == true)
 	{
@@ -165,125 +180,97 @@ void rosaic_node::ROSaicNode::configureRx()
 		
 		ss << "sno, Stream" << std::to_string(stream) << ", " << rx_port << ", GSV, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D"; 
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_pvtcartesian_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", PVTCartesian, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_pvtgeodetic_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", PVTGeodetic, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_poscovcartesian_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", PosCovCartesian, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_poscovgeodetic_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", PosCovGeodetic, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_atteuler_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", AttEuler, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (publish_attcoveuler_ == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", AttCovEuler, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (g_publish_gpsfix == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", ChannelStatus, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 		ss.str(std::string()); // avoids invoking the std::string constructor
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", MeasEpoch, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 		ss.str(std::string()); 
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", DOP, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 		ss.str(std::string()); 
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", VelCovGeodetic, " << pvt_sec_or_msec << 
 			std::to_string(rx_period_pvt) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	if (g_publish_diagnostics == true)
 	{
 		std::stringstream ss;
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", ReceiverStatus, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 		ss.str(std::string()); 
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", QualityInd, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 		ss.str(std::string()); 
 		ss << "sso, Stream" << std::to_string(stream) << ", " << rx_port << ", ReceiverSetup, " << rest_sec_or_msec << 
 			std::to_string(rx_period_rest) << "\x0D";
-		IO.send(ss.str());
+		commands.push_back(ss.str());
 		++stream;
-		g_response_condition.wait(lock, [](){return g_response_received;});
-		g_response_received = false;
 	}
 	
 	// Setting the marker-to-ARP offsets. This comes after the "sso, ..., ReceiverSetup, ..." command, 
@@ -293,21 +280,20 @@ void rosaic_node::ROSaicNode::configureRx()
 		ss << "sao, Main, " << string_utilities::trimString(std::to_string(delta_e_)) << ", " << 
 			string_utilities::trimString(std::to_string(delta_n_)) << ", " << 
 			string_utilities::trimString(std::to_string(delta_u_)) << ", \"" << ant_type_ << "\", \"" << ant_serial_nr_ << 
-			"\", 0 \x0D"; 
-		IO.send(ss.str());
+			"\", 0 \x0D";
+		commands.push_back(ss.str());
 	}
-	g_response_condition.wait(lock, [](){return g_response_received;});
-	g_response_received = false;
-	
+
 	// Configuring the NTRIP connection
 	// First disable any existing NTRIP connection on NTR1
 	{
 		std::stringstream ss;
-		ss << "snts, NTR1, off \x0D"; 
-		IO.send(ss.str());
+		ss << "snts, NTR1, off \x0D";
+		commands.push_back(ss.str());
 	}
-	g_response_condition.wait(lock, [](){return g_response_received;});
-	g_response_received = false;
+	// The very last command redirecting the corrections port is sent without waiting for its "$R" response
+	// (as was always the case), hence it is kept out of the response-matched command list.
+	std::string trailing_command;
 	if (rx_has_internet_)
 	{
 		if (mode_ == "off")
@@ -318,21 +304,17 @@ void rosaic_node::ROSaicNode::configureRx()
 			{
 				std::stringstream ss;
 				ss << "snts, NTR1, " << mode_ << ", " << caster_ << ", " << std::to_string(caster_port_) << ", " << 
-					username_ << ", " << password_ << ", " << mountpoint_ << ", " << ntrip_version_ << ", " << send_gga_ << " \x0D"; 
-				IO.send(ss.str());
+					username_ << ", " << password_ << ", " << mountpoint_ << ", " << ntrip_version_ << ", " << send_gga_ << " \x0D";
+				commands.push_back(ss.str());
 			}
-			g_response_condition.wait(lock, [](){return g_response_received;});
-			g_response_received = false;
 		}
 		else if (mode_ == "Client-Sapcorda")
 		{
 			{
 				std::stringstream ss;
-				ss << "snts, NTR1, Client-Sapcorda, , , , , , , , \x0D"; 
-				IO.send(ss.str());
+				ss << "snts, NTR1, Client-Sapcorda, , , , , , , , \x0D";
+				commands.push_back(ss.str());
 			}
-			g_response_condition.wait(lock, [](){return g_response_received;});
-			g_response_received = false;
 		}
 		else 
 		{
@@ -347,32 +329,113 @@ void rosaic_node::ROSaicNode::configureRx()
 			{
 				std::stringstream ss;
 				// In case IPS1 was used before, old configuration is lost of course.
-				ss << "siss, IPS1, " << std::to_string(rx_input_corrections_tcp_) << ", TCP2Way \x0D"; 
-				IO.send(ss.str());
+				ss << "siss, IPS1, " << std::to_string(rx_input_corrections_tcp_) << ", TCP2Way \x0D";
+				commands.push_back(ss.str());
 			}
-			g_response_condition.wait(lock, [](){return g_response_received;});
-			g_response_received = false;
 			{
 				std::stringstream ss;
-				ss << "sno, Stream" << std::to_string(stream) << ", IPS1, GGA, " << pvt_sec_or_msec << 
+				ss << "sno, Stream" << std::to_string(stream) << ", IPS1, GGA, " << pvt_sec_or_msec <<
 					std::to_string(rx_period_pvt) << " \x0D";
 				++stream;
-				IO.send(ss.str());
+				commands.push_back(ss.str());
 			}
-			g_response_condition.wait(lock, [](){return g_response_received;});
-			g_response_received = false;
 		}
 		{
 			std::stringstream ss;
 			if (proto == "tcp")
 			{
-				ss << "sdio, IPS1, " << rtcm_version_ << ", +SBF+NMEA \x0D"; 
+				ss << "sdio, IPS1, " << rtcm_version_ << ", +SBF+NMEA \x0D";
 			}
 			else
 			{
-				ss << "sdio, " << rx_input_corrections_serial_ << ", " << rtcm_version_ << ", +SBF+NMEA \x0D"; 
+				ss << "sdio, " << rx_input_corrections_serial_ << ", " << rtcm_version_ << ", +SBF+NMEA \x0D";
 			}
-			IO.send(ss.str());
+			trailing_command = ss.str();
+		}
+	}
+
+	// Fingerprint of the configuration about to be pushed: in case the very same command set already
+	// reached this receiver earlier (cf. the config_fingerprint_path parameter), re-sending it is skipped
+	// entirely. Note that the Rx port the output streams are directed to is embedded in the commands and
+	// hence in the fingerprint, s.t. e.g. a TCP session that comes back under a different connection
+	// descriptor fails the comparison and is reconfigured in full.
+	std::string fingerprint;
+	if (!config_fingerprint_path_.empty())
+	{
+		std::stringstream fingerprint_ss;
+		fingerprint_ss << device_ << "\n" << trailing_command << "\n";
+		for (std::size_t i = 0; i < commands.size(); ++i)
+		{
+			fingerprint_ss << commands[i] << "\n";
+		}
+		fingerprint = std::to_string(std::hash<std::string>()(fingerprint_ss.str()));
+		std::ifstream fingerprint_file(config_fingerprint_path_.c_str());
+		std::string cached_fingerprint;
+		if (fingerprint_file && std::getline(fingerprint_file, cached_fingerprint) &&
+			cached_fingerprint == fingerprint)
+		{
+			ROS_INFO("Cached configuration fingerprint matches, skipping all %li configuration commands..",
+				commands.size());
+			return;
+		}
+	}
+
+	if (pipelined_configuration_)
+	{
+		// Pipelined mode: all commands are streamed out back-to-back and their "$R" responses matched
+		// asynchronously in readCallback() against the outstanding-command queue, cf. the isResponse()
+		// branch there. The Rx buffers its command line and processes it strictly in order, hence one
+		// send-then-wait round trip per command - several seconds of startup with a full block list,
+		// during which the watchdog clock keeps ticking - collapses into a single round trip overall.
+		g_response_count = 0;
+		g_response_error.clear();
+		g_outstanding_commands.assign(commands.begin(), commands.end());
+		for (std::size_t i = 0; i < commands.size(); ++i)
+		{
+			IO.send(commands[i]);
+		}
+		g_response_condition.wait(lock, [&commands](){return g_response_count >= commands.size() ||
+			!g_response_error.empty();});
+		if (!g_response_error.empty())
+		{
+			// Failing fast: the rejected command is named and the remainder of the configuration aborted,
+			// instead of blindly waiting on responses that follow an already broken setup.
+			std::string rejected = g_response_error;
+			rejected.erase(std::remove(rejected.begin(), rejected.end(), '\x0D'), rejected.end());
+			ROS_ERROR("The Rx rejected the command \"%s\" - aborting the remainder of the configuration.",
+				rejected.c_str());
+			g_outstanding_commands.clear();
+			return;
+		}
+	}
+	else
+	{
+		// Sequential mode: one command at a time, waiting for its "$R" response before sending the next
+		for (std::size_t i = 0; i < commands.size(); ++i)
+		{
+			IO.send(commands[i]);
+			g_response_condition.wait(lock, [](){return g_response_received;});
+			g_response_received = false;
+		}
+	}
+
+	if (!trailing_command.empty())
+	{
+		IO.send(trailing_command);
+	}
+
+	// The fingerprint is only persisted now that the whole command set went through without a "$R?" error
+	// response, s.t. an aborted configuration is re-attempted in full on the next (re)connection.
+	if (!fingerprint.empty())
+	{
+		std::ofstream fingerprint_file(config_fingerprint_path_.c_str(), std::ios::trunc);
+		if (fingerprint_file)
+		{
+			fingerprint_file << fingerprint << "\n";
+		}
+		else
+		{
+			ROS_WARN("Could not persist the configuration fingerprint to %s.", config_fingerprint_path_.c_str());
 		}
 	}
 	ROS_DEBUG("Leaving configureRx() method");
@@ -383,10 +446,33 @@ void rosaic_node::ROSaicNode::getROSParams()
 	g_nh->param("device", device_, std::string("/dev/ttyACM0"));
 	getROSInt("serial/baudrate", baudrate_, static_cast<uint32_t>(115200));
 	g_nh->param("serial/hw_flow_control", hw_flow_control_, std::string("off"));
+	g_nh->param("serial/max_ingest_latency_ms", serial_max_ingest_latency_ms_, 0.0f);
 	g_nh->param("serial/rx_serial_port", rx_serial_port_, std::string("USB1"));
 	
 	g_nh->param("reconnect_delay_s", reconnect_delay_s_, 4.0f);
-	
+	g_nh->param("reconnect_backoff_max_s", reconnect_backoff_max_s_, 60.0f);
+	g_nh->param("pipelined_configuration", pipelined_configuration_, true);
+	g_nh->param("config_fingerprint_path", config_fingerprint_path_, std::string());
+
+	getROSInt("decode_threads", decode_threads_, static_cast<uint32_t>(0));
+	getROSInt("ring_buffer_size", ring_buffer_size_, static_cast<uint32_t>(65536));
+
+	// Thread tuning parameters
+	g_nh->param("thread_tuning/io_cpu_affinity", io_cpu_affinity_, -1);
+	g_nh->param("thread_tuning/parse_cpu_affinity", parse_cpu_affinity_, -1);
+	g_nh->param("thread_tuning/rt_priority", rt_priority_, 0);
+
+	// Multi-receiver parameters
+	getROSInt("multi_receiver/io_thread_pool_size", io_thread_pool_size_, static_cast<uint32_t>(0));
+	g_nh->param("multi_receiver/secondary_devices", secondary_devices_, std::string());
+	g_nh->param("multi_receiver/secondary_topic_prefixes", secondary_topic_prefixes_, std::string());
+
+	// Raw capture parameters
+	g_nh->param("raw_capture/enabled", raw_capture_enabled_, false);
+	g_nh->param("raw_capture/directory", raw_capture_directory_, std::string("/tmp"));
+	getROSInt("raw_capture/max_file_size_mb", raw_capture_max_file_size_mb_, static_cast<uint32_t>(256));
+	getROSInt("raw_capture/file_count", raw_capture_file_count_, static_cast<uint32_t>(4));
+
 	// Polling period parameters
 	getROSInt("polling_period/pvt", polling_period_pvt_, static_cast<uint32_t>(1000));
 	if (polling_period_pvt_ != 10 && polling_period_pvt_ != 20 && polling_period_pvt_ != 50 && polling_period_pvt_ != 100 
@@ -436,18 +522,53 @@ void rosaic_node::ROSaicNode::getROSParams()
 	g_nh->param("publish/poscovgeodetic", publish_poscovgeodetic_, true);
 	g_nh->param("publish/atteuler", publish_atteuler_, true);
 	g_nh->param("publish/attcoveuler", publish_attcoveuler_, true);
+	g_nh->param("publish/raw_sbf_ids", raw_sbf_ids_, std::string());
 
 	// To be implemented: RTCM, setting datum, raw data settings, PPP, SBAS, fix mode...
 	ROS_DEBUG("Finished getROSParams() method");
 
 }
 
-void rosaic_node::ROSaicNode::initializeIO() 
+void rosaic_node::ROSaicNode::initializeIO()
 {
 	ROS_DEBUG("Called initializeIO() method");
+	// The shared io_service thread pool must be running before the first stream is initialized, otherwise
+	// each stream spawns its own dedicated I/O thread, as was always the case.
+	if (io_thread_pool_size_ > 0)
+	{
+		io_comm_rx::Comm_IO::startIOThreadPool(io_thread_pool_size_);
+	}
+	// Likewise, the raw capture configuration must be in place before the first stream's AsyncManager is
+	// constructed, since each AsyncManager creates its capture instance (if any) right then.
+	io_comm_rx::RawCapture::configure(raw_capture_enabled_, raw_capture_directory_,
+		raw_capture_max_file_size_mb_, raw_capture_file_count_);
+	// With decode_threads at 0 (the default), no pool is spawned and the decode + publish stage keeps
+	// running on the parser thread, cf. the DecodeWorkerPool class.
+	io_comm_rx::DecodeWorkerPool::configure(decode_threads_);
+	// The reconnect engine of the Comm_IO class takes over once an established connection is lost again,
+	// retrying with exponential backoff and re-running the configuration of the primary receiver afterwards.
+	io_comm_rx::Comm_IO::configureReconnect(reconnect_delay_s_, reconnect_backoff_max_s_);
+	// Likewise for the serial ingest latency budget, which initializeSerial() applies to its AsyncManager.
+	io_comm_rx::Comm_IO::configureSerialBatching(serial_max_ingest_latency_ms_);
+	// ..and for the receive ring capacity every AsyncManager is constructed with.
+	io_comm_rx::Comm_IO::configureRingBuffer(static_cast<std::size_t>(ring_buffer_size_));
+	// The pinning and scheduling policy every subsequently spawned I/O and parser thread is subjected to,
+	// cf. the ThreadTuning class.
+	io_comm_rx::ThreadTuning::configure(io_cpu_affinity_, parse_cpu_affinity_, rt_priority_);
+	IO.setReconnectedCallback(boost::bind(&ROSaicNode::handleReconnection, this));
 	boost::smatch match;
 	// In fact: smatch is a typedef of match_results<string::const_iterator>
-	if (boost::regex_match(device_, match, boost::regex("(tcp)://(.+):(\\d+)"))) 
+	sbf_file_playback_ = false;
+	udp_ = false;
+	if (boost::regex_match(device_, match, boost::regex("(file)://(.+)")))
+	{
+		// Offline playback of a logged SBF file: no connection is established here; the ROSaicNode
+		// constructor replays the file once defineMessages() has put the handlers in place.
+		sbf_file_playback_ = true;
+		sbf_file_path_ = match[2];
+		serial_ = false;
+	}
+	else if (boost::regex_match(device_, match, boost::regex("(tcp|udp)://(.+):(\\d+)")))
 	// \d means decimal, however, in the regular expression, the \ is a special character, which needs 
 	// to be escaped on its own as well..
 	// Note that regex_match can be used with a smatch object to store results, or without. In any case, 
@@ -464,25 +585,96 @@ void rosaic_node::ROSaicNode::initializeIO()
 			tcp_port_ = match[3];
 			
 			serial_ = false;
-			boost::thread temporary_thread(boost::bind(&ROSaicNode::connect, this));
+			connect();
+		}
+		else
+		{
+			// I.e. the udp:// scheme, with the host being either the sender's address (unicast) or the
+			// multicast group to join, cf. Comm_IO::initializeUDP()
+			udp_host_ = match[2];
+			udp_port_ = match[3];
+
+			udp_ = true;
+			serial_ = false;
+			connect();
+		}
+	}
+	else
+	{
+		serial_ = true;
+		connect();
+	}
+	// Secondary receivers, if any: each gets its own Comm_IO (and hence its own stream ID and topic prefix),
+	// with all streams multiplexed over the shared io_service thread pool started above.
+	if (!secondary_devices_.empty())
+	{
+		typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+		boost::char_separator<char> sep(",");
+		tokenizer device_tokens(secondary_devices_, sep);
+		std::vector<std::string> devices(device_tokens.begin(), device_tokens.end());
+		tokenizer prefix_tokens(secondary_topic_prefixes_, sep);
+		std::vector<std::string> prefixes(prefix_tokens.begin(), prefix_tokens.end());
+		for (std::size_t i = 0; i < devices.size(); ++i)
+		{
+			std::size_t stream_id = i + 1;
+			if (stream_id >= MAX_RX_STREAMS)
+			{
+				ROS_ERROR("At most %li secondary devices are supported, ignoring %s and onwards..",
+					MAX_RX_STREAMS - 1, devices[i].c_str());
+				break;
+			}
+			std::string prefix;
+			if (i < prefixes.size()) prefix = prefixes[i];
+			else prefix = "/aux" + std::to_string(stream_id);
+			secondary_IOs_.push_back(boost::shared_ptr<io_comm_rx::Comm_IO>(
+				new io_comm_rx::Comm_IO(stream_id, prefix)));
+			boost::thread temporary_thread(boost::bind(&ROSaicNode::connectSecondary, this, stream_id,
+				devices[i]));
 			temporary_thread.detach();
-		} 
-		else 
+		}
+	}
+	ROS_DEBUG("Leaving initializeIO() method");
+}
+
+void rosaic_node::ROSaicNode::connectSecondary(std::size_t stream_id, std::string device)
+{
+	ROS_DEBUG("Called connectSecondary() method for device %s", device.c_str());
+	io_comm_rx::Comm_IO& secondary_io = *(secondary_IOs_[stream_id - 1]);
+	boost::smatch match;
+	try
+	{
+		if (boost::regex_match(device, match, boost::regex("(tcp|udp)://(.+):(\\d+)")))
 		{
+			std::string proto(match[1]);
+			std::string host(match[2]);
+			std::string port(match[3]);
+			if (proto == "tcp")
 			{
-				std::stringstream ss;
-				ss << "Protocol '" << proto << "' is unsupported.";
-				ROS_ERROR("%s", ss.str().c_str());
+				ROS_INFO("Connecting to secondary device tcp://%s:%s ...", host.c_str(), port.c_str());
+				secondary_io.initializeTCP(host, port);
+			}
+			else
+			{
+				ROS_INFO("Listening to secondary device udp://%s:%s ...", host.c_str(), port.c_str());
+				secondary_io.initializeUDP(host, port);
 			}
 		}
-	} 
-	else 
+		else
+		{
+			ROS_INFO("Connecting serially to secondary device %s, targeted baudrate: %u", device.c_str(),
+				baudrate_);
+			secondary_io.initializeSerial(device, baudrate_, hw_flow_control_);
+		}
+	}
+	catch (std::runtime_error& e)
 	{
-		serial_ = true;
-		boost::thread temporary_thread(boost::bind(&ROSaicNode::connect, this));
-		temporary_thread.detach();
+		{
+			std::stringstream ss;
+			ss << "Connecting to secondary device " << device << " failed due to: " << e.what();
+			ROS_ERROR("%s", ss.str().c_str());
+		}
 	}
-	ROS_DEBUG("Leaving initializeIO() method");
+	ROS_DEBUG("Leaving connectSecondary() method");
 }
 
 void rosaic_node::ROSaicNode::connect() 
@@ -491,9 +683,11 @@ void rosaic_node::ROSaicNode::connect()
 	ROS_DEBUG("Setting ROS timer for calling reconnect() method until connection succeds");
 	reconnect_timer_ = g_nh->createTimer(ros::Duration(reconnect_delay_s_), &ROSaicNode::reconnect, this);
 	reconnect_timer_.start();
-	ROS_DEBUG("Started ROS timer for calling reconnect() method until connection succeds"); 
-	ros::spin();
-	ROS_DEBUG("Leaving connect() method"); // This will never be output since ros::spin() is on the line above.
+	ROS_DEBUG("Started ROS timer for calling reconnect() method until connection succeds");
+	// The timer fires on the callback queue of g_nh, serviced by the AsyncSpinner started in main() when
+	// running standalone and by the nodelet manager's spinner threads when running as a nodelet; connect()
+	// itself used to ros::spin() here, which inside a nodelet manager would contend for the callback queue.
+	ROS_DEBUG("Leaving connect() method");
 }
 
 //! In serial mode (not USB, since the Rx port is then called USB1 or USB2), please ensure that you are 
@@ -532,6 +726,31 @@ void rosaic_node::ROSaicNode::reconnect(const ros::TimerEvent& event)
 				connection_condition_.notify_one();
 			}
 		}
+		else if (udp_)
+		{
+			bool initialize_udp_return = false;
+			try
+			{
+				ROS_INFO("Binding udp://%s:%s ...", udp_host_.c_str(), udp_port_.c_str());
+				initialize_udp_return = IO.initializeUDP(udp_host_, udp_port_);
+			}
+			catch (std::runtime_error& e)
+			{
+				{
+					std::stringstream ss;
+					ss << "IO.initializeUDP() failed for host " << udp_host_ << " on port " << udp_port_ <<
+						" due to: " << e.what();
+					ROS_ERROR("%s", ss.str().c_str());
+				}
+			}
+			if (initialize_udp_return)
+			{
+				boost::mutex::scoped_lock lock(connection_mutex_);
+				connected_ = true;
+				lock.unlock();
+				connection_condition_.notify_one();
+			}
+		}
 		else
 		{
 			bool initialize_tcp_return = false;
@@ -561,6 +780,21 @@ void rosaic_node::ROSaicNode::reconnect(const ros::TimerEvent& event)
 	ROS_DEBUG("Leaving reconnect() method");
 }
 
+void rosaic_node::ROSaicNode::handleReconnection()
+{
+	if (udp_)
+	{
+		// The rebound UDP socket simply resumes the ingest-only stream, there is nothing to configure.
+		ROS_INFO("UDP socket re-established, resuming ingest..");
+		return;
+	}
+	ROS_INFO("Connection to the Rx re-established, re-running its configuration..");
+	// The Rx's output streams might point to the stale connection descriptor of the lost TCP session;
+	// configureRx() re-runs the escape-sequence handshake and - unless the cached fingerprint still
+	// matches - the whole command set.
+	configureRx();
+}
+
 //! initializeSerial is not self-contained: The for loop in Callbackhandlers' handle method would 
 //! never open a specific handler unless the handler is added (=inserted) to the C++ map via this 
 //! function. This way, the specific handler can be called, in which in turn RxMessage's read() method is 
@@ -572,50 +806,64 @@ void rosaic_node::ROSaicNode::defineMessages()
 	
 	if (publish_gpgga_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgga>("$GPGGA");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgga>(RX_ID_GPGGA, "/gpgga");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgga>(RX_ID_GPGGA, true);
 	}
 	if (publish_gprmc_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gprmc>("$GPRMC");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gprmc>(RX_ID_GPRMC, "/gprmc");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gprmc>(RX_ID_GPRMC, true);
 	}
 	if (publish_gpgsa_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsa>("$GPGSA");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgsa>(RX_ID_GPGSA, "/gpgsa");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsa>(RX_ID_GPGSA, true);
 	}
 	if (publish_gpgsv_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>("$GPGSV");
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>("$GLGSV");
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>("$GAGSV");
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>("$GBGSV");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgsv>(RX_ID_GPGSV, "/gpgsv");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgsv>(RX_ID_GLGSV, "/gpgsv");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgsv>(RX_ID_GAGSV, "/gpgsv");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::Gpgsv>(RX_ID_GBGSV, "/gpgsv");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GPGSV, true);
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GLGSV, true);
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GAGSV, true);
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GBGSV, true);
 	}
 	if (publish_pvtcartesian_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PVTCartesian>("4006");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::PVTCartesian>(4006, "/pvtcartesian");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PVTCartesian>(4006, true);
 	}
 	if (publish_pvtgeodetic_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PVTGeodetic>("4007");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::PVTGeodetic>(4007, "/pvtgeodetic");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PVTGeodetic>(4007, true);
 	}
 	if (publish_poscovcartesian_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PosCovCartesian>("5905");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::PosCovCartesian>(5905, "/poscovcartesian");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PosCovCartesian>(5905, true);
 	}
 	if (publish_poscovgeodetic_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PosCovGeodetic>("5906");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::PosCovGeodetic>(5906, "/poscovgeodetic");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::PosCovGeodetic>(5906, true);
 	}
 	if (publish_atteuler_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::AttEuler>("5938");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::AttEuler>(5938, "/atteuler");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::AttEuler>(5938, true);
 	}
 	if (publish_attcoveuler_ == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::AttCovEuler>("5939");
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::AttCovEuler>(5939, "/attcoveuler");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<septentrio_gnss_driver::AttCovEuler>(5939, true);
 	}
 	if (g_publish_gpst == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("GPST");
+		io_comm_rx::PublisherRegistry::advertise<sensor_msgs::TimeReference>(RX_ID_GPST, "/gpst");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(RX_ID_GPST, true);
 	}
 	if (g_publish_navsatfix == true)
 	{
@@ -623,7 +871,8 @@ void rosaic_node::ROSaicNode::defineMessages()
 		{
 			ROS_ERROR("For a proper NavSatFix message, please set the publish/pvtgeodetic and the publish/poscovgeodetic ROSaic parameters both to true.");
 		}
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<sensor_msgs::NavSatFix>("NavSatFix");
+		io_comm_rx::PublisherRegistry::advertise<sensor_msgs::NavSatFix>(RX_ID_NAVSATFIX, "/navsatfix");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<sensor_msgs::NavSatFix>(RX_ID_NAVSATFIX, true);
 	}
 	if (g_publish_gpsfix == true)
 	{
@@ -631,12 +880,32 @@ void rosaic_node::ROSaicNode::defineMessages()
 		{
 			ROS_ERROR("For a proper GPSFix message, please set the publish/pvtgeodetic and the publish/poscovgeodetic ROSaic parameters both to true.");
 		}
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<gps_common::GPSFix>("GPSFix");
+		io_comm_rx::PublisherRegistry::advertise<gps_common::GPSFix>(RX_ID_GPSFIX, "/gpsfix");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<gps_common::GPSFix>(RX_ID_GPSFIX, true);
 		// The following blocks are never published, yet are needed for the construction of the GPSFix message, hence we have empty callbacks.
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("4013"); // ChannelStatus block
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("4027"); // MeasEpoch block
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("4001"); // DOP block
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("5908"); // VelCovGeodetic block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4013, true); // ChannelStatus block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4027, true); // MeasEpoch block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4001, true); // DOP block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(5908, true); // VelCovGeodetic block
+	}
+	if (g_publish_measepoch == true)
+	{
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::MeasEpoch>(4027, "/measepoch");
+		if (g_publish_gpsfix == false)
+		// The 4027 callback was already inserted above in case GPSFix is published; a second one would make
+		// the block decode (and publish) twice.
+		{
+			IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4027, true); // MeasEpoch block
+		}
+	}
+	if (g_publish_channelstatus == true)
+	{
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::ChannelStatus>(4013, "/channelstatus");
+		if (g_publish_gpsfix == false)
+		// Cf. the remark for MeasEpoch right above
+		{
+			IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4013, true); // ChannelStatus block
+		}
 	}
 	if (g_publish_pose == true)
 	{
@@ -645,14 +914,40 @@ void rosaic_node::ROSaicNode::defineMessages()
 		{
 			ROS_ERROR("For a proper PoseWithCovarianceStamped message, please set the publish/pvtgeodetic, publish/poscovgeodetic, publish_atteuler and publish_attcoveuler ROSaic parameters all to true.");
 		}
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<geometry_msgs::PoseWithCovarianceStamped>("PoseWithCovarianceStamped");
+		io_comm_rx::PublisherRegistry::advertise<geometry_msgs::PoseWithCovarianceStamped>(RX_ID_POSEWITHCOVARIANCESTAMPED, "/pose");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<geometry_msgs::PoseWithCovarianceStamped>(RX_ID_POSEWITHCOVARIANCESTAMPED, true);
 	}
 	if (g_publish_diagnostics == true)
 	{
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<diagnostic_msgs::DiagnosticArray>("DiagnosticArray");
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("4014"); // ReceiverStatus block
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("4082"); // QualityInd block
-		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>("5902"); // ReceiverSetup block
+		io_comm_rx::PublisherRegistry::advertise<diagnostic_msgs::DiagnosticArray>(RX_ID_DIAGNOSTICARRAY, "/diagnostics");
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<diagnostic_msgs::DiagnosticArray>(RX_ID_DIAGNOSTICARRAY, true);
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4014, true); // ReceiverStatus block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(4082, true); // QualityInd block
+		IO.handlers_.callbackmap_ = IO.getHandlers().insert<int32_t>(5902, true); // ReceiverSetup block
+	}
+	if (!raw_sbf_ids_.empty())
+	{
+		// Lazy-decode passthrough: the listed SBF blocks are republished verbatim as
+		// septentrio_gnss_driver::RawBlock messages with zero decoding, cf. the RawBlockCallbackHandler
+		// class. All of them share the /rawblock topic (and hence the single publisher filed under the
+		// synthetic RX_ID_RAWBLOCK key), s.t. a block ID whose decoded counterpart is enabled above keeps
+		// its own publisher slot.
+		io_comm_rx::PublisherRegistry::advertise<septentrio_gnss_driver::RawBlock>(RX_ID_RAWBLOCK, "/rawblock");
+		typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
+		boost::char_separator<char> sep(", ");
+		tokenizer id_tokens(raw_sbf_ids_, sep);
+		for (tokenizer::iterator token = id_tokens.begin(); token != id_tokens.end(); ++token)
+		{
+			int32_t message_key = 0;
+			if (!string_utilities::toInt32(*token, message_key) || message_key <= 0 ||
+				message_key > 8191) // SBF block numbers are 13-bit
+			{
+				ROS_ERROR("Ignoring invalid SBF block ID '%s' in the publish/raw_sbf_ids parameter..",
+					token->c_str());
+				continue;
+			}
+			IO.getHandlers().insertRaw(static_cast<RxIDType>(message_key));
+		}
 	}
 	// so on and so forth...
 	ROS_DEBUG("Leaving defineMessages() method");
@@ -673,6 +968,10 @@ bool g_publish_gpsfix;
 bool g_publish_pose;
 //! Whether or not to publish the diagnostic_msgs::DiagnosticArray message
 bool g_publish_diagnostics;
+//! Whether or not to publish the septentrio_gnss_driver::MeasEpoch message
+bool g_publish_measepoch;
+//! Whether or not to publish the septentrio_gnss_driver::ChannelStatus message
+bool g_publish_channelstatus;
 //! The frame ID used in the header of every published ROS message
 std::string g_frame_id;
 //! The number of leap seconds that have been inserted into the UTC time
@@ -683,6 +982,14 @@ boost::mutex g_response_mutex;
 bool g_response_received;
 //! Condition variable complementing "g_response_mutex"
 boost::condition_variable g_response_condition;
+//! Number of command replies received from the Rx since the counter was last reset, cf. the pipelined
+//! mode of configureRx()
+uint32_t g_response_count;
+//! Commands sent to the Rx whose replies are still outstanding, in sending order; solely populated during
+//! a pipelined configuration phase
+std::deque<std::string> g_outstanding_commands;
+//! The first command the Rx rejected during a pipelined configuration phase, empty if none (yet)
+std::string g_response_error;
 //! Mutex to control changes of global variable "g_cd_received"
 boost::mutex g_cd_mutex;
 //! Determines whether the connection descriptor was received from the Rx
@@ -696,46 +1003,6 @@ bool g_read_cd;
 std::string g_rx_tcp_port;
 //! Since after SSSSSSSSSSS we need to wait for second connection descriptor, we have to count the connection descriptors
 uint32_t g_cd_count;
-//! For GPSFix: Whether the ChannelStatus block of the current epoch has arrived or not
-bool g_channelstatus_has_arrived_gpsfix;
-//! For GPSFix: Whether the MeasEpoch block of the current epoch has arrived or not
-bool g_measepoch_has_arrived_gpsfix;
-//! For GPSFix: Whether the DOP block of the current epoch has arrived or not
-bool g_dop_has_arrived_gpsfix;
-//! For GPSFix: Whether the PVTGeodetic block of the current epoch has arrived or not
-bool g_pvtgeodetic_has_arrived_gpsfix;
-//! For GPSFix: Whether the PosCovGeodetic block of the current epoch has arrived or not
-bool g_poscovgeodetic_has_arrived_gpsfix;
-//! For GPSFix: Whether the VelCovGeodetic block of the current epoch has arrived or not
-bool g_velcovgeodetic_has_arrived_gpsfix;
-//! For GPSFix: Whether the AttEuler block of the current epoch has arrived or not
-bool g_atteuler_has_arrived_gpsfix;
-//! For GPSFix: Whether the AttCovEuler block of the current epoch has arrived or not
-bool g_attcoveuler_has_arrived_gpsfix;
-//! For NavSatFix: Whether the PVTGeodetic block of the current epoch has arrived or not
-bool g_pvtgeodetic_has_arrived_navsatfix;
-//! For NavSatFix: Whether the PosCovGeodetic block of the current epoch has arrived or not
-bool g_poscovgeodetic_has_arrived_navsatfix;
-//! For PoseWithCovarianceStamped: Whether the PVTGeodetic block of the current epoch has arrived or not
-bool g_pvtgeodetic_has_arrived_pose;
-//! For PoseWithCovarianceStamped: Whether the PosCovGeodetic block of the current epoch has arrived or not
-bool g_poscovgeodetic_has_arrived_pose;
-//! For PoseWithCovarianceStamped: Whether the AttEuler block of the current epoch has arrived or not
-bool g_atteuler_has_arrived_pose;
-//! For PoseWithCovarianceStamped: Whether the AttCovEuler block of the current epoch has arrived or not
-bool g_attcoveuler_has_arrived_pose;
-//! For DiagnosticArray: Whether the ReceiverStatus block of the current epoch has arrived or not
-bool g_receiverstatus_has_arrived_diagnostics;
-//! For DiagnosticArray: Whether the QualityInd block of the current epoch has arrived or not
-bool g_qualityind_has_arrived_diagnostics;
-//! A C++ map for keeping track of the SBF blocks necessary to construct the GPSFix ROS message
-std::map<std::string, uint32_t> g_GPSFixMap;
-//! A C++ map for keeping track of the SBF blocks necessary to construct the NavSatFix ROS message
-std::map<std::string, uint32_t> g_NavSatFixMap;
-//! A C++ map for keeping track of SBF blocks necessary to construct the PoseWithCovarianceStamped ROS message
-std::map<std::string, uint32_t> g_PoseWithCovarianceStampedMap;
-//! A C++ map for keeping track of SBF blocks necessary to construct the DiagnosticArray ROS message
-std::map<std::string, uint32_t> g_DiagnosticArrayMap;
 //! Node Handle for the ROSaic node
 //! You must initialize the NodeHandle in the "main" function (or in any method called 
 //! indirectly or directly by the main function). 
@@ -744,10 +1011,8 @@ boost::shared_ptr<ros::NodeHandle> g_nh;
 //! Queue size for ROS publishers
 const uint32_t g_ROS_QUEUE_SIZE = 1;
 
-int main(int argc, char** argv) 
+void rosaic_node::initializeGlobals()
 {
-	ros::init(argc, argv, "septentrio_gnss");
-	g_nh.reset(new ros::NodeHandle("~")); 
 	g_nh->param("use_gnss_time", g_use_gnss_time, true);
 	g_nh->param("frame_id", g_frame_id, (std::string) "gnss"); 
 	g_nh->param("publish/gpst", g_publish_gpst, true);
@@ -755,35 +1020,12 @@ int main(int argc, char** argv)
 	g_nh->param("publish/gpsfix", g_publish_gpsfix, true);
 	g_nh->param("publish/pose", g_publish_pose, true);
 	g_nh->param("publish/diagnostics", g_publish_diagnostics, true);
+	g_nh->param("publish/measepoch", g_publish_measepoch, false);
+	g_nh->param("publish/channelstatus", g_publish_channelstatus, false);
 	rosaic_node::getROSInt("leap_seconds", g_leap_seconds, static_cast<uint32_t>(18));
-	
+
 	g_response_received = false;
 	g_cd_received = false;
 	g_read_cd = true;
 	g_cd_count = 0;
-	g_channelstatus_has_arrived_gpsfix = false;
-	g_measepoch_has_arrived_gpsfix = false;
-	g_dop_has_arrived_gpsfix = false;
-	g_pvtgeodetic_has_arrived_gpsfix = false;
-	g_pvtgeodetic_has_arrived_navsatfix = false;
-	g_pvtgeodetic_has_arrived_pose = false;
-	g_poscovgeodetic_has_arrived_gpsfix = false;
-	g_poscovgeodetic_has_arrived_navsatfix = false;
-	g_poscovgeodetic_has_arrived_pose = false;
-	g_velcovgeodetic_has_arrived_gpsfix = false;
-	g_atteuler_has_arrived_gpsfix = false;
-	g_atteuler_has_arrived_pose = false;
-	g_attcoveuler_has_arrived_gpsfix = false;
-	g_attcoveuler_has_arrived_pose = false;
-	g_receiverstatus_has_arrived_diagnostics = false;
-	g_qualityind_has_arrived_diagnostics = false;
-	
-	// The info logging level seems to be default, hence we modify log level momentarily..
-	// The following is the C++ version of rospy.init_node('my_ros_node', log_level=rospy.DEBUG)
-	if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME,
-								   ros::console::levels::Debug)) //debug is lowest level, shows everything
-	ros::console::notifyLoggerLevelsChanged();
-	
-	rosaic_node::ROSaicNode rx_node; // This launches everything we need, in theory :)
-	return 0;
 }
@@ -17,64 +17,50 @@
 // THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
 // AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
 // IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
-// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
-// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
-// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
-// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
-// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
-// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-// POSSIBILITY OF SUCH DAMAGE. 
+// POSSIBILITY OF SUCH DAMAGE.
 //
 // *****************************************************************************
 
-// ROS includes
-#include <ros/ros.h>
-
-// C++ library includes
-#include <cstdint>
-#include <algorithm>
-
-#ifndef CIRCULAR_BUFFER_HPP
-#define CIRCULAR_BUFFER_HPP
+#include <septentrio_gnss_driver/node/rosaic_node.hpp>
 
 /**
- * @file circular_buffer.hpp
- * @brief Declares a class for creating, writing to and reading from a circular bufffer
- * @date 25/09/20
+ * @file rosaic_node_main.cpp
+ * @date 01/09/26
+ * @brief The standalone entry point of the ROSaic driver
+ *
+ * Split off rosaic_node.cpp s.t. the ROSaicNode class can also be hosted by the nodelet entry point
+ * (cf. the ROSaicNodelet class), which must not bring a main() along into its library.
  */
 
-/**
- * @class CircularBuffer
- * @brief Class for creating, writing to and reading from a circular buffer
- */
-class CircularBuffer
+int main(int argc, char** argv)
 {
-	public:
-		//! Constructor of CircularBuffer
-		explicit CircularBuffer(std::size_t capacity);
-		//! Destructor of CircularBuffer
-		~CircularBuffer();
-		//! Returns size_
-		std::size_t size() const { return size_; }
-		//! Returns capacity_
-		std::size_t capacity() const { return capacity_; }
-		//! Returns number of bytes written.
-		std::size_t write(const uint8_t *data, std::size_t bytes);
-		//! Returns number of bytes read.
-		std::size_t read(uint8_t *data, std::size_t bytes); 
+	ros::init(argc, argv, "septentrio_gnss");
+	g_nh.reset(new ros::NodeHandle("~"));
+	rosaic_node::initializeGlobals();
+	// When running standalone, topics are advertised on the node's own handle and messages are handed to
+	// roscpp by reference, exactly as always; the nodelet entry point injects its private handle (and the
+	// intra-process flag) here instead.
+	io_comm_rx::PublisherRegistry::setNodeHandle(g_nh);
 
-	private:
-		//! Specifies where we start writing
-		std::size_t head_;
-		//! Specifies where we start reading
-		std::size_t tail_;
-		//! Number of bytes that have been written but not yet read
-		std::size_t size_;
-		//! Capacity of the circular buffer
-		std::size_t capacity_;
-		//! Pointer that always points to the same memory address, hence could be const pointer
-		uint8_t * data_;
-};
+	// The info logging level seems to be default, hence we modify log level momentarily..
+	// The following is the C++ version of rospy.init_node('my_ros_node', log_level=rospy.DEBUG)
+	if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME,
+								   ros::console::levels::Debug)) //debug is lowest level, shows everything
+	ros::console::notifyLoggerLevelsChanged();
 
-# endif // for CIRCULAR_BUFFER_HPP
\ No newline at end of file
+	// The spinner services the callback queue (most prominently the reconnect timer, cf.
+	// ROSaicNode::connect()) from the moment the node is constructed, since the constructor itself blocks
+	// until the receiver is connected and configured.
+	ros::AsyncSpinner spinner(1);
+	spinner.start();
+	rosaic_node::ROSaicNode rx_node; // This launches everything we need, in theory :)
+	ros::waitForShutdown();
+	return 0;
+}
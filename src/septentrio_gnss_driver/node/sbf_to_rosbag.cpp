@@ -0,0 +1,439 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#include <septentrio_gnss_driver/communication/callback_handlers.hpp>
+// ROS includes
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <topic_tools/shape_shifter.h>
+// Boost includes
+#include <boost/make_shared.hpp>
+// C++ library includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+// POSIX includes for the memory-mapped input and the worker processes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+/**
+ * @file sbf_to_rosbag.cpp
+ * @date 01/09/26
+ * @brief Offline SBF-to-rosbag converter decoding recorded SBF/NMEA streams through the driver's pipeline
+ *
+ * Usage: rosrun septentrio_gnss_driver septentrio_gnss_driver_sbf_to_rosbag [-j <jobs>] [-o <out.bag>] <capture.sbf> [<capture2.sbf> ..]
+ *
+ * Each given capture file (e.g. recorded via the raw_capture ROS parameters, or any logged SBF/NMEA
+ * stream) is decoded through CallbackHandlers::readCallback() and the RxMessage decode switch exactly as
+ * live receiver bytes would be, and every ROS message the live node would have published is written into
+ * a rosbag instead (<capture>.bag next to the input, or the -o path for a single input). Timestamps stem
+ * from the blocks' TOW/WNc fields, making the conversion deterministic; no ROS master is needed.
+ *
+ * With -j above 1 (the default is the machine's core count), the input is split at sync boundaries into
+ * one segment per job and the segments are converted by concurrently forked worker processes - processes
+ * rather than threads, since the decode path keeps its SBF state receiver-global - whose partial bags are
+ * then merged in time order. Like the live node joining a running stream, each worker knows nothing of
+ * the blocks before its segment: messages composed from several blocks (NMEA stamps, navsatfix, gpsfix,
+ * pose, diagnostics) hence start a few blocks into each segment, once their constituents have all been
+ * seen. Convert with -j 1 where that warm-up matters more than wall-clock time.
+ */
+
+//! Upper bound on the per-file worker count s.t. a boundless -j does not fork absurdly
+static const std::size_t MAX_JOBS = 64;
+//! Minimum worker segment size in bytes; below jobs * MIN_SEGMENT_SIZE the fork + merge overhead
+//! outweighs the parallelism and the worker count is scaled down accordingly
+static const std::size_t MIN_SEGMENT_SIZE = 4194304;
+
+/**
+ * @class BagSink
+ * @brief PublishSink writing every diverted message into a rosbag, cf. PublisherRegistry::divert()
+ */
+class BagSink : public io_comm_rx::PublishSink
+{
+	public:
+		/**
+		 * @brief Constructor of the BagSink class, creates (or overwrites) the bag file
+		 * @param[in] bag_path Path of the bag file to write
+		 */
+		explicit BagSink(const std::string& bag_path): record_count_(0)
+		{
+			bag_.open(bag_path, rosbag::bagmode::Write);
+		}
+
+		void handle(const std::string& topic, const ros::Time& stamp, const std::string& md5sum,
+			const std::string& datatype, const std::string& definition, const uint8_t* bytes,
+			uint32_t size)
+		{
+			// The ShapeShifter re-inflates the serialized bytes under their original type metadata,
+			// s.t. the resulting bag record is indistinguishable from one recorded off the live node.
+			topic_tools::ShapeShifter shape_shifter;
+			shape_shifter.morph(md5sum, datatype, definition, std::string());
+			ros::serialization::IStream stream(const_cast<uint8_t*>(bytes), size);
+			shape_shifter.read(stream);
+			// A zero stamp (e.g. a Do-Not-Use TOW before the receiver's first fix) would be rejected
+			// by the bag format, hence the clamp to the smallest representable time.
+			bag_.write(topic, stamp.isZero() ? ros::TIME_MIN : stamp, shape_shifter);
+			++record_count_;
+		}
+
+		//! Returns the number of records written into the bag so far
+		uint64_t recordCount() const { return record_count_; }
+
+	private:
+		//! The bag the diverted messages are written into, closed by its destructor
+		rosbag::Bag bag_;
+		//! Number of records written into the bag so far
+		uint64_t record_count_;
+};
+
+//! Inserts the same publish-only handlers ROSaicNode::defineMessages() would, cf. the benchmark executable
+static void insertHandlers(io_comm_rx::CallbackHandlers& handlers)
+{
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgga>(RX_ID_GPGGA, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gprmc>(RX_ID_GPRMC, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsa>(RX_ID_GPGSA, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GPGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GLGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GAGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::Gpgsv>(RX_ID_GBGSV, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PVTCartesian>(4006, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PVTGeodetic>(4007, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PosCovCartesian>(5905, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::PosCovGeodetic>(5906, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::AttEuler>(5938, true);
+	handlers.callbackmap_ = handlers.insert<septentrio_gnss_driver::AttCovEuler>(5939, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(RX_ID_GPST, true);
+	handlers.callbackmap_ = handlers.insert<sensor_msgs::NavSatFix>(RX_ID_NAVSATFIX, true);
+	handlers.callbackmap_ = handlers.insert<gps_common::GPSFix>(RX_ID_GPSFIX, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(4013, true); // ChannelStatus block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4027, true); // MeasEpoch block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4001, true); // DOP block
+	handlers.callbackmap_ = handlers.insert<int32_t>(5908, true); // VelCovGeodetic block
+	handlers.callbackmap_ = handlers.insert<geometry_msgs::PoseWithCovarianceStamped>(RX_ID_POSEWITHCOVARIANCESTAMPED, true);
+	handlers.callbackmap_ = handlers.insert<diagnostic_msgs::DiagnosticArray>(RX_ID_DIAGNOSTICARRAY, true);
+	handlers.callbackmap_ = handlers.insert<int32_t>(4014, true); // ReceiverStatus block
+	handlers.callbackmap_ = handlers.insert<int32_t>(4082, true); // QualityInd block
+	handlers.callbackmap_ = handlers.insert<int32_t>(5902, true); // ReceiverSetup block
+}
+
+/**
+ * @brief Decodes one segment of a mapped capture file through readCallback()
+ *
+ * The same chunking contract as the file:// playback mode of the node: readCallback() throws the offset
+ * of the first not-yet-parsable byte whenever a message straddles the chunk boundary, and the next chunk
+ * restarts right there.
+ * @param[in] handlers The callback handlers the segment's chunks are handed to
+ * @param[in] data Pointer to the start of the mapped capture file
+ * @param[in] begin Offset of the segment's first byte
+ * @param[in] end Offset one past the segment's last byte
+ */
+static void decodeSegment(io_comm_rx::CallbackHandlers& handlers, const uint8_t* data, std::size_t begin,
+	std::size_t end)
+{
+	const std::size_t CHUNK_SIZE = 1048576;
+	std::size_t offset = begin;
+	while (offset < end)
+	{
+		std::size_t chunk = std::min(CHUNK_SIZE, end - offset);
+		try
+		{
+			handlers.readCallback(data + offset, chunk);
+			offset += chunk;
+		}
+		catch (std::size_t& parsing_failed_here)
+		{
+			// The segment (or file) ends mid-message: whatever block straddles the boundary was cut
+			// short by the recording or belongs to the next worker's resync, cf. convertFile().
+			if (parsing_failed_here == 0) break;
+			offset += parsing_failed_here;
+		}
+	}
+}
+
+/**
+ * @brief Merges the workers' partial bags into the final bag, in time order
+ * @param[in] part_paths Paths of the partial bags, deleted after a successful merge
+ * @param[in] bag_path Path of the final bag to write
+ * @param[out] record_count Accumulates the number of records written into the final bag
+ * @return True in case all parts could be read and the final bag written, false otherwise
+ */
+static bool mergeParts(const std::vector<std::string>& part_paths, const std::string& bag_path,
+	uint64_t& record_count)
+{
+	try
+	{
+		rosbag::Bag out_bag;
+		out_bag.open(bag_path, rosbag::bagmode::Write);
+		std::vector<boost::shared_ptr<rosbag::Bag>> part_bags;
+		// One time-ordered view over all parts at once: the merge is thereby a single sequential pass,
+		// however the records interleave across the segment boundaries.
+		rosbag::View view;
+		for (std::size_t part = 0; part < part_paths.size(); ++part)
+		{
+			part_bags.push_back(boost::make_shared<rosbag::Bag>(part_paths[part], rosbag::bagmode::Read));
+			view.addQuery(*part_bags.back());
+		}
+		for (rosbag::View::iterator it = view.begin(); it != view.end(); ++it)
+		{
+			out_bag.write(it->getTopic(), it->getTime(), *it, it->getConnectionHeader());
+			++record_count;
+		}
+	}
+	catch (rosbag::BagException& e)
+	{
+		std::fprintf(stderr, "Could not merge the partial bags into %s: %s\n", bag_path.c_str(), e.what());
+		return false;
+	}
+	for (std::size_t part = 0; part < part_paths.size(); ++part)
+	{
+		unlink(part_paths[part].c_str());
+	}
+	return true;
+}
+
+/**
+ * @brief Converts one capture file into one bag, split across up to "jobs" worker processes
+ * @param[in] file_path Path of the capture file
+ * @param[in] bag_path Path of the bag file to write
+ * @param[in] jobs Upper bound on the number of concurrent worker processes
+ * @return True in case the file was converted and the bag written, false otherwise
+ */
+static bool convertFile(const std::string& file_path, const std::string& bag_path, std::size_t jobs)
+{
+	int fd = open(file_path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		std::fprintf(stderr, "Could not open capture file %s: %s\n", file_path.c_str(), strerror(errno));
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0)
+	{
+		std::fprintf(stderr, "Could not stat capture file %s or file is empty.\n", file_path.c_str());
+		close(fd);
+		return false;
+	}
+	std::size_t file_size = static_cast<std::size_t>(file_stat.st_size);
+	const uint8_t* data = static_cast<const uint8_t*>(mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		std::fprintf(stderr, "Could not mmap capture file %s: %s\n", file_path.c_str(), strerror(errno));
+		return false;
+	}
+	madvise(const_cast<uint8_t*>(data), file_size, MADV_SEQUENTIAL);
+
+	// Small files are not worth the fork + merge overhead, cf. MIN_SEGMENT_SIZE.
+	if (jobs > file_size / MIN_SEGMENT_SIZE) jobs = std::max<std::size_t>(1, file_size / MIN_SEGMENT_SIZE);
+
+	// The segment boundaries: equidistant split points, each advanced to the next recognizable sync
+	// pair s.t. every worker starts at a message start. A sync pair occurring inside a block's binary
+	// payload is a false start the decode path weeds out itself (the CRC check fails, the scanner moves
+	// on), at the cost of the one block straddling that boundary.
+	std::vector<std::size_t> boundaries;
+	boundaries.push_back(0);
+	for (std::size_t job = 1; job < jobs; ++job)
+	{
+		std::size_t target = file_size / jobs * job;
+		std::size_t aligned = static_cast<std::size_t>(
+			io_comm_rx::scanForSyncPair(data + target, file_size - target, false) - data);
+		if (aligned > boundaries.back() && aligned < file_size) boundaries.push_back(aligned);
+	}
+	boundaries.push_back(file_size);
+	std::size_t segments = boundaries.size() - 1;
+
+	bool converted = true;
+	uint64_t record_count = 0;
+	if (segments == 1)
+	{
+		// No parallelism to be had: decode straight into the final bag, no workers, no merge.
+		BagSink sink(bag_path);
+		io_comm_rx::PublisherRegistry::divert(&sink);
+		io_comm_rx::CallbackHandlers handlers;
+		insertHandlers(handlers);
+		decodeSegment(handlers, data, 0, file_size);
+		io_comm_rx::PublisherRegistry::divert(NULL);
+		record_count = sink.recordCount();
+	}
+	else
+	{
+		std::vector<pid_t> workers;
+		std::vector<std::string> part_paths;
+		for (std::size_t segment = 0; segment < segments; ++segment)
+		{
+			part_paths.push_back(bag_path + ".part" + std::to_string(segment));
+			pid_t pid = fork();
+			if (pid == -1)
+			{
+				std::fprintf(stderr, "Could not fork worker %li for %s: %s\n", segment,
+					file_path.c_str(), strerror(errno));
+				converted = false;
+				part_paths.pop_back();
+				break;
+			}
+			if (pid == 0)
+			{
+				// The worker: decodes its segment of the (inherited, read-only) mapping into its own
+				// partial bag. A fresh address space per segment, since the decode path keeps its SBF
+				// state (the last_.. blocks, the composite collation) receiver-global.
+				int worker_status = 0;
+				try
+				{
+					BagSink sink(part_paths.back());
+					io_comm_rx::PublisherRegistry::divert(&sink);
+					io_comm_rx::CallbackHandlers handlers;
+					insertHandlers(handlers);
+					decodeSegment(handlers, data, boundaries[segment], boundaries[segment + 1]);
+				}
+				catch (rosbag::BagException& e)
+				{
+					std::fprintf(stderr, "Worker %li could not write %s: %s\n", segment,
+						part_paths.back().c_str(), e.what());
+					worker_status = 1;
+				}
+				_exit(worker_status);
+			}
+			workers.push_back(pid);
+		}
+		for (std::size_t worker = 0; worker < workers.size(); ++worker)
+		{
+			int status = 0;
+			waitpid(workers[worker], &status, 0);
+			if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) converted = false;
+		}
+		if (converted) converted = mergeParts(part_paths, bag_path, record_count);
+	}
+
+	munmap(const_cast<uint8_t*>(data), file_size);
+	if (converted)
+	{
+		std::printf("%s: %lu bytes -> %s (%lu records, %li worker%s)\n", file_path.c_str(),
+			static_cast<unsigned long>(file_size), bag_path.c_str(),
+			static_cast<unsigned long>(record_count), segments, segments == 1 ? "" : "s");
+	}
+	return converted;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t jobs = static_cast<std::size_t>(std::max(1L, sysconf(_SC_NPROCESSORS_ONLN)));
+	std::string out_path;
+	std::vector<std::string> input_paths;
+	for (int arg = 1; arg < argc; ++arg)
+	{
+		std::string argument(argv[arg]);
+		if (argument == "-j" && arg + 1 < argc)
+		{
+			jobs = static_cast<std::size_t>(std::max(1, atoi(argv[++arg])));
+		}
+		else if (argument == "-o" && arg + 1 < argc)
+		{
+			out_path = argv[++arg];
+		}
+		else
+		{
+			input_paths.push_back(argument);
+		}
+	}
+	if (input_paths.empty())
+	{
+		std::fprintf(stderr, "Usage: %s [-j <jobs>] [-o <out.bag>] <capture.sbf> [<capture2.sbf> ..]\n",
+			argv[0]);
+		return 1;
+	}
+	if (!out_path.empty() && input_paths.size() > 1)
+	{
+		std::fprintf(stderr, "-o names one output bag, yet %lu input files were given; converting each "
+			"input into <input>.bag instead requires dropping -o.\n",
+			static_cast<unsigned long>(input_paths.size()));
+		return 1;
+	}
+	jobs = std::min(jobs, MAX_JOBS);
+
+	// roscpp's clock must be up for the (rare) headerless stamps, yet no node handle (and hence no ROS
+	// master) is needed since all publishing is diverted into the bags.
+	ros::Time::init();
+	// Decode everything the node can decode, timestamps from the TOW/WNc fields s.t. the conversion is
+	// deterministic and the bag records sort by measurement time.
+	g_use_gnss_time = true;
+	g_frame_id = "gnss";
+	g_leap_seconds = 18;
+	g_publish_gpst = true;
+	g_publish_navsatfix = true;
+	g_publish_gpsfix = true;
+	g_publish_pose = true;
+	g_publish_diagnostics = true;
+	g_publish_measepoch = true;
+	g_publish_channelstatus = true;
+	g_read_cd = false;
+
+	bool all_files_converted = true;
+	for (std::size_t input = 0; input < input_paths.size(); ++input)
+	{
+		std::string bag_path = out_path.empty() ? input_paths[input] + ".bag" : out_path;
+		all_files_converted &= convertFile(input_paths[input], bag_path, jobs);
+	}
+	return all_files_converted ? 0 : 1;
+}
+
+// The linked translation units reference the driver's globals, which the node's TU defines right next to
+// its own main(); the converter, carrying its own main() instead, hence supplies its own definitions.
+// Cf. rosaic_node.cpp for the documentation of each.
+bool g_use_gnss_time;
+bool g_publish_gpst;
+bool g_publish_navsatfix;
+bool g_publish_gpsfix;
+bool g_publish_pose;
+bool g_publish_diagnostics;
+bool g_publish_measepoch;
+bool g_publish_channelstatus;
+std::string g_frame_id;
+uint32_t g_leap_seconds;
+boost::mutex g_response_mutex;
+bool g_response_received;
+boost::condition_variable g_response_condition;
+uint32_t g_response_count;
+std::deque<std::string> g_outstanding_commands;
+std::string g_rx_tcp_port;
+std::string g_response_error;
+boost::mutex g_cd_mutex;
+bool g_cd_received;
+boost::condition_variable g_cd_condition;
+bool g_read_cd;
+uint32_t g_cd_count;
+boost::shared_ptr<ros::NodeHandle> g_nh;
+const uint32_t g_ROS_QUEUE_SIZE = 1;
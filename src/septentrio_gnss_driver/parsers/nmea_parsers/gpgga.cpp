@@ -29,6 +29,7 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
 
 /**
  * @file gpgga.cpp
@@ -46,33 +47,34 @@ const std::string GpggaParser::getMessageID() const
 /**
  * Caution: Due to the occurrence of the throw keyword, this method parseASCII should be called within a try / catch framework...
  * Note: This method is called from within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: It would be sentence.get_body()[15] if anybody ever needs it.
+ * the argument "sentence" here, though the checksum is never parsed: It would be sentence[15] if anybody ever needs it.
  */
 septentrio_gnss_driver::GpggaPtr GpggaParser::parseASCII(const NMEASentence& sentence) noexcept(false)
 {
-	//ROS_DEBUG("Just testing that first entry is indeed what we expect it to be: %s", sentence.get_body()[0].c_str());
+	//ROS_DEBUG("Just testing that first entry is indeed what we expect it to be: %s", sentence[0].c_str());
 	// Check the length first, which should be 16 elements.
 	const size_t LEN = 16;
-	if (sentence.get_body().size() > LEN || sentence.get_body().size() < LEN)
+	if (sentence.size() > LEN || sentence.size() < LEN)
 	{
 		std::stringstream error;
-		error << "GGA parsing failed: Expected GPGGA length is " << LEN << ", but actual length is " << sentence.get_body().size();
+		error << "GGA parsing failed: Expected GPGGA length is " << LEN << ", but actual length is " << sentence.size();
 		throw ParseException(error.str());
 	}
 
-	septentrio_gnss_driver::GpggaPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgga>();
+	static io_comm_rx::MessagePool<septentrio_gnss_driver::Gpgga> pool;
+	septentrio_gnss_driver::GpggaPtr msg = pool.acquire();
 	msg->header.frame_id = g_frame_id;
 
-	msg->message_id = sentence.get_body()[0];
+	msg->message_id = sentence[0].to_string();
 
-	if (sentence.get_body()[1].empty() || sentence.get_body()[1] == "0")
+	if (sentence[1].empty() || sentence[1] == "0")
 	{
 		msg->utc_seconds = 0;
 	}
 	else
 	{
 		double utc_double;
-		if (string_utilities::toDouble(sentence.get_body()[1], utc_double))
+		if (string_utilities::toDouble(sentence[1], utc_double))
 		{
 			if(g_use_gnss_time)
 			{
@@ -103,28 +105,28 @@ septentrio_gnss_driver::GpggaPtr GpggaParser::parseASCII(const NMEASentence& sen
 	bool valid = true;
 
 	double latitude = 0.0;
-	valid = valid && parsing_utilities::parseDouble(sentence.get_body()[2], latitude);
-	msg->lat = parsing_utilities::convertDMSToDegrees(latitude);
+	valid = valid && parsing_utilities::parseDMSDegrees(sentence[2], latitude);
+	msg->lat = latitude;
 
 	double longitude = 0.0;
-	valid = valid && parsing_utilities::parseDouble(sentence.get_body()[4], longitude);
-	msg->lon = parsing_utilities::convertDMSToDegrees(longitude);
-
-	msg->lat_dir = sentence.get_body()[3];
-	msg->lon_dir = sentence.get_body()[5];
-	valid = valid && parsing_utilities::parseUInt32(sentence.get_body()[6], msg->gps_qual);
-	valid = valid && parsing_utilities::parseUInt32(sentence.get_body()[7], msg->num_sats);
-	//ROS_INFO("Valid is %s so far with number of satellites in use being %s", valid ? "true" : "false", sentence.get_body()[7].c_str());
-
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[8], msg->hdop);
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[9], msg->alt);
-	msg->altitude_units = sentence.get_body()[10];
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[11], msg->undulation);
-	msg->undulation_units = sentence.get_body()[12];
+	valid = valid && parsing_utilities::parseDMSDegrees(sentence[4], longitude);
+	msg->lon = longitude;
+
+	msg->lat_dir = sentence[3].to_string();
+	msg->lon_dir = sentence[5].to_string();
+	valid = valid && parsing_utilities::parseUInt32(sentence[6], msg->gps_qual);
+	valid = valid && parsing_utilities::parseUInt32(sentence[7], msg->num_sats);
+	//ROS_INFO("Valid is %s so far with number of satellites in use being %s", valid ? "true" : "false", sentence[7].c_str());
+
+	valid = valid && parsing_utilities::parseFloat(sentence[8], msg->hdop);
+	valid = valid && parsing_utilities::parseFloat(sentence[9], msg->alt);
+	msg->altitude_units = sentence[10].to_string();
+	valid = valid && parsing_utilities::parseFloat(sentence[11], msg->undulation);
+	msg->undulation_units = sentence[12].to_string();
 	double diff_age_temp;
-	valid = valid && parsing_utilities::parseDouble(sentence.get_body()[13], diff_age_temp);
+	valid = valid && parsing_utilities::parseDouble(sentence[13], diff_age_temp);
 	msg->diff_age = static_cast<uint32_t>(round(diff_age_temp));
-	msg->station_id = sentence.get_body()[14];
+	msg->station_id = sentence[14].to_string();
 
 	if (!valid)
 	{
@@ -29,6 +29,7 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
 
 /**
  * @file gpgsa.cpp
@@ -46,42 +47,43 @@ const std::string GpgsaParser::getMessageID() const
 /**
  * Caution: Due to the occurrence of the throw keyword, this method ParseASCII should be called within a try / catch framework...
  * Note: This method is called from within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: It would be sentence.get_body()[18] if anybody ever needs it.
+ * the argument "sentence" here, though the checksum is never parsed: It would be sentence[18] if anybody ever needs it.
  */
 septentrio_gnss_driver::GpgsaPtr GpgsaParser::parseASCII(const NMEASentence& sentence) noexcept(false)
 {
 	
 	// Checking the length first, it should be 19 elements
 	const size_t LENGTH = 19;
-	if (sentence.get_body().size() != LENGTH)
+	if (sentence.size() != LENGTH)
 	{
 		std::stringstream error;
 		error << "Expected GPGSA length is " << LENGTH
-			<< ". The actual length is " << sentence.get_body().size();
+			<< ". The actual length is " << sentence.size();
 		throw ParseException(error.str());
 	}
 
-	septentrio_gnss_driver::GpgsaPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgsa>();
+	static io_comm_rx::MessagePool<septentrio_gnss_driver::Gpgsa> pool;
+	septentrio_gnss_driver::GpgsaPtr msg = pool.acquire();
 	msg->header.frame_id = g_frame_id;
-	msg->message_id = sentence.get_body()[0];
-	msg->auto_manual_mode = sentence.get_body()[1];
-	parsing_utilities::parseUInt8(sentence.get_body()[2], msg->fix_mode);
+	msg->message_id = sentence[0].to_string();
+	msg->auto_manual_mode = sentence[1].to_string();
+	parsing_utilities::parseUInt8(sentence[2], msg->fix_mode);
 	// Words 3-14 of the sentence are SV PRNs. Copying only the non-null strings..
 	// 0 is the character needed to fill the new character space, in case 12 (first argument) is larger than sv_ids.
 	msg->sv_ids.resize(12, 0); 
 	size_t n_svs = 0;
-	for (std::vector<std::string>::const_iterator id = sentence.get_body().begin()+3; id < sentence.get_body().begin()+15; ++id)
+	for (size_t id = 3; id < 15; ++id)
 	{
-		if (! id->empty())
+		if (! sentence[id].empty())
 		{
-			parsing_utilities::parseUInt8(*id, msg->sv_ids[n_svs]);
+			parsing_utilities::parseUInt8(sentence[id], msg->sv_ids[n_svs]);
 			++n_svs;
 		}
 	}
 	msg->sv_ids.resize(n_svs);
 
-	parsing_utilities::parseFloat(sentence.get_body()[15], msg->pdop);
-	parsing_utilities::parseFloat(sentence.get_body()[16], msg->hdop);
-	parsing_utilities::parseFloat(sentence.get_body()[17], msg->vdop);
+	parsing_utilities::parseFloat(sentence[15], msg->pdop);
+	parsing_utilities::parseFloat(sentence[16], msg->hdop);
+	parsing_utilities::parseFloat(sentence[17], msg->vdop);
 	return msg;
 }
\ No newline at end of file
@@ -29,6 +29,7 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
 
 /**
  * @file gpgsv.cpp
@@ -47,7 +48,7 @@ const std::string GpgsvParser::getMessageID() const
  * Caution: Due to the occurrence of the throw keyword, this method parseASCII should be called within a try / catch framework...
  * Note: This method is called from within the read() method of the RxMessage class by including the checksum part in
  * the argument "sentence" here, though the checksum is never parsed: E.g. for message with 4 Svs it would be 
- * sentence.get_body()[20] if anybody ever needs it.
+ * sentence[20] if anybody ever needs it.
  */
 septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sentence) noexcept(false)
 {
@@ -55,17 +56,18 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 	
 	const size_t MIN_LENGTH = 4;
 	// Checking that the message is at least as long as a GPGSV with no satellites
-	if (sentence.get_body().size() < MIN_LENGTH)
+	if (sentence.size() < MIN_LENGTH)
 	{
 		std::stringstream error;
 		error << "Expected GSV length is at least " << MIN_LENGTH
-          << ". The actual length is " << sentence.get_body().size();
+          << ". The actual length is " << sentence.size();
 		throw ParseException(error.str());
 	}
-	septentrio_gnss_driver::GpgsvPtr msg = boost::make_shared<septentrio_gnss_driver::Gpgsv>();
+	static io_comm_rx::MessagePool<septentrio_gnss_driver::Gpgsv> pool;
+	septentrio_gnss_driver::GpgsvPtr msg = pool.acquire();
 	msg->header.frame_id = g_frame_id;
-	msg->message_id = sentence.get_body()[0];
-	if (!parsing_utilities::parseUInt8(sentence.get_body()[1], msg->n_msgs))
+	msg->message_id = sentence[0].to_string();
+	if (!parsing_utilities::parseUInt8(sentence[1], msg->n_msgs))
 	{
 		throw ParseException("Error parsing n_msgs in GSV.");
 	}
@@ -76,7 +78,7 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		throw ParseException(error.str());
 	}
 
-	if (!parsing_utilities::parseUInt8(sentence.get_body()[2], msg->msg_number))
+	if (!parsing_utilities::parseUInt8(sentence[2], msg->msg_number))
 	{
 		throw ParseException("Error parsing msg_number in GSV.");
 	}
@@ -86,7 +88,7 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		error << "msg_number in GSV is larger than n_msgs: " << msg->msg_number << " > " << msg->n_msgs << ".";
 		throw ParseException(error.str());
 	}
-	if (!parsing_utilities::parseUInt8(sentence.get_body()[3], msg->n_satellites))
+	if (!parsing_utilities::parseUInt8(sentence[3], msg->n_satellites))
 	{
 		throw ParseException("Error parsing n_satellites in GSV.");
 	}
@@ -118,13 +120,13 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		expected_length += 4;
 	}
 	//ROS_DEBUG("number of sats is %u but nsats in sentence if msg_number = max is %u and msg->msg_number == msg->n_msgs is %s and nsats in sentence is %li", msg->n_satellites, msg->n_satellites % static_cast<uint8_t>(4), msg->msg_number == msg->n_msgs ? "true" : "false", n_sats_in_sentence);
-	if (sentence.get_body().size() != expected_length && sentence.get_body().size() != expected_length - 1)
+	if (sentence.size() != expected_length && sentence.size() != expected_length - 1)
 	{
 		std::stringstream ss;
-		for (size_t i = 0; i < sentence.get_body().size(); ++i)
+		for (size_t i = 0; i < sentence.size(); ++i)
 		{
-			ss << sentence.get_body()[i];
-			if ((i+1) < sentence.get_body().size())
+			ss << sentence[i];
+			if ((i+1) < sentence.size())
 			{
 				ss << ",";
 			}
@@ -132,7 +134,7 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		std::stringstream error;
 		error << "Expected GSV length is " << expected_length << " for message with "
 			<< n_sats_in_sentence << " satellites. The actual length is "
-			<< sentence.get_body().size() << ".\n" << ss.str().c_str();
+			<< sentence.size() << ".\n" << ss.str().c_str();
 		throw ParseException(error.str());
 	}
 	
@@ -140,14 +142,14 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 	msg->satellites.resize(n_sats_in_sentence);
 	for (size_t sat = 0, index=MIN_LENGTH; sat < n_sats_in_sentence; ++sat, index += 4)
 	{
-		if (!parsing_utilities::parseUInt8(sentence.get_body()[index], msg->satellites[sat].prn))
+		if (!parsing_utilities::parseUInt8(sentence[index], msg->satellites[sat].prn))
 		{
 			std::stringstream error;
 			error << "Error parsing PRN for satellite " << sat << " in GSV.";
 			throw ParseException(error.str());
 		}
 		float elevation;
-		if (!parsing_utilities::parseFloat(sentence.get_body()[index + 1], elevation))
+		if (!parsing_utilities::parseFloat(sentence[index + 1], elevation))
 		{
 			std::stringstream error;
 			error << "Error parsing elevation for satellite " << sat << " in GSV.";
@@ -156,7 +158,7 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		msg->satellites[sat].elevation = static_cast<uint8_t>(elevation);
 
 		float azimuth;
-		if (!parsing_utilities::parseFloat(sentence.get_body()[index + 2], azimuth))
+		if (!parsing_utilities::parseFloat(sentence[index + 2], azimuth))
 		{
 			std::stringstream error;
 			error << "Error parsing azimuth for satellite " << sat << " in GSV.";
@@ -164,14 +166,14 @@ septentrio_gnss_driver::GpgsvPtr GpgsvParser::parseASCII(const NMEASentence& sen
 		}
 		msg->satellites[sat].azimuth = static_cast<uint16_t>(azimuth);
 
-		if ((index + 3) >= sentence.get_body().size() || sentence.get_body()[index + 3].empty())
+		if ((index + 3) >= sentence.size() || sentence[index + 3].empty())
 		{
 			msg->satellites[sat].snr = -1;
 		}
 		else
 		{
 			uint8_t snr;
-			if (!parsing_utilities::parseUInt8(sentence.get_body()[index + 3], snr))
+			if (!parsing_utilities::parseUInt8(sentence[index + 3], snr))
 			{
 				std::stringstream error;
 				error << "Error parsing snr for satellite " << sat << " in GSV.";
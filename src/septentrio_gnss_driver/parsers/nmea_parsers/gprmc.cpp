@@ -29,6 +29,7 @@
 // *****************************************************************************
 
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
 
 /**
  * @file gprmc.cpp
@@ -46,7 +47,7 @@ const std::string GprmcParser::getMessageID() const
 /**
  * Caution: Due to the occurrence of the throw keyword, this method ParseASCII should be called within a try / catch framework...
  * Note: This method is called from within the read() method of the RxMessage class by including the checksum part in
- * the argument "sentence" here, though the checksum is never parsed: It would be sentence.get_body()[13] if anybody ever needs it.
+ * the argument "sentence" here, though the checksum is never parsed: It would be sentence[13] if anybody ever needs it.
  * The status character can be 'A' (for Active) or 'V' (for Void), signaling whether the GPS was active when the positioning was made. 
  * If it is void, the GPS could not make a good positioning and you should thus ignore it. This usually occurs when the GPS is still 
  * searching for satellites. WasLastGPRMCValid() will return false in this case.
@@ -58,29 +59,30 @@ septentrio_gnss_driver::GprmcPtr GprmcParser::parseASCII(const NMEASentence& sen
 	const size_t LEN_MIN = 13;
 	const size_t LEN_MAX = 14;
 
-	if (sentence.get_body().size() > LEN_MAX || 
-      sentence.get_body().size() < LEN_MIN)
+	if (sentence.size() > LEN_MAX || 
+      sentence.size() < LEN_MIN)
 	{
 		std::stringstream error;
 		error << "Expected GPRMC length is between " << LEN_MIN << " and "
-			<< LEN_MAX << ". The actual length is " << sentence.get_body().size();
+			<< LEN_MAX << ". The actual length is " << sentence.size();
 		throw ParseException(error.str());
 	}
 
-	septentrio_gnss_driver::GprmcPtr msg = boost::make_shared<septentrio_gnss_driver::Gprmc>();
+	static io_comm_rx::MessagePool<septentrio_gnss_driver::Gprmc> pool;
+	septentrio_gnss_driver::GprmcPtr msg = pool.acquire();
 	
 	msg->header.frame_id = g_frame_id;
 	
-	msg->message_id = sentence.get_body()[0];
+	msg->message_id = sentence[0].to_string();
 	
-	if (sentence.get_body()[1].empty() || sentence.get_body()[1] == "0")
+	if (sentence[1].empty() || sentence[1] == "0")
 	{
 		msg->utc_seconds = 0;
 	}
 	else
 	{
 		double utc_double;
-		if (string_utilities::toDouble(sentence.get_body()[1], utc_double))
+		if (string_utilities::toDouble(sentence[1], utc_double))
 		{
 			msg->utc_seconds = parsing_utilities::convertUTCDoubleToSeconds(utc_double);
 			if(g_use_gnss_time)
@@ -108,39 +110,39 @@ septentrio_gnss_driver::GprmcPtr GprmcParser::parseASCII(const NMEASentence& sen
 	bool valid = true;
 	bool to_be_ignored = false;
 
-	msg->position_status = sentence.get_body()[2];
+	msg->position_status = sentence[2].to_string();
 	// Check to see whether this message should be ignored
-	to_be_ignored &= !(sentence.get_body()[2].compare("A") == 0); // 0 : if both strings are equal.
-	to_be_ignored &= (sentence.get_body()[3].empty() || sentence.get_body()[5].empty());
+	to_be_ignored &= !(sentence[2].compare("A") == 0); // 0 : if both strings are equal.
+	to_be_ignored &= (sentence[3].empty() || sentence[5].empty());
 
 	double latitude = 0.0;
-	valid = valid && parsing_utilities::parseDouble(sentence.get_body()[3], latitude);
-	msg->lat = parsing_utilities::convertDMSToDegrees(latitude);
+	valid = valid && parsing_utilities::parseDMSDegrees(sentence[3], latitude);
+	msg->lat = latitude;
 
 	double longitude = 0.0;
-	valid = valid && parsing_utilities::parseDouble(sentence.get_body()[5], longitude);
-	msg->lon = parsing_utilities::convertDMSToDegrees(longitude);
+	valid = valid && parsing_utilities::parseDMSDegrees(sentence[5], longitude);
+	msg->lon = longitude;
 
-	msg->lat_dir = sentence.get_body()[4];
-	msg->lon_dir = sentence.get_body()[6];
+	msg->lat_dir = sentence[4].to_string();
+	msg->lon_dir = sentence[6].to_string();
 
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[7], msg->speed);
+	valid = valid && parsing_utilities::parseFloat(sentence[7], msg->speed);
 	msg->speed *= KNOTS_TO_MPS;
 
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[8], msg->track);
+	valid = valid && parsing_utilities::parseFloat(sentence[8], msg->track);
 
-	std::string date_str = sentence.get_body()[9];
+	boost::string_ref date_str = sentence[9];
 	if (!date_str.empty())
 	{
-		msg->date = std::string("20") + date_str.substr(4, 2) +
-                std::string("-") + date_str.substr(2, 2) +
-                std::string("-") + date_str.substr(0, 2);
+		msg->date = std::string("20") + date_str.substr(4, 2).to_string() +
+                std::string("-") + date_str.substr(2, 2).to_string() +
+                std::string("-") + date_str.substr(0, 2).to_string();
 	}
-	valid = valid && parsing_utilities::parseFloat(sentence.get_body()[10], msg->mag_var);
-	msg->mag_var_direction = sentence.get_body()[11];
-	if (sentence.get_body().size() == LEN_MAX) 
+	valid = valid && parsing_utilities::parseFloat(sentence[10], msg->mag_var);
+	msg->mag_var_direction = sentence[11].to_string();
+	if (sentence.size() == LEN_MAX) 
 	{
-		msg->mode_indicator = sentence.get_body()[12];
+		msg->mode_indicator = sentence[12].to_string();
 	}
 
 	if (!valid)
@@ -64,6 +64,15 @@ namespace parsing_utilities
 		return string_utilities::toDouble(string, value) || string.empty();
 	}
 
+	/**
+	 * It checks whether an error occurred (via errno) and whether junk characters
+	 * exist within "string", and returns true if the latter two tests are negative or when the string is empty, false otherwise.
+	 */
+	bool parseDouble(boost::string_ref string, double& value)
+	{
+		return string_utilities::toDouble(string, value) || string.empty();
+	}
+
 	/** 
 	 * The function assumes that the bytes in the buffer are already arranged with the same endianness as the local platform.
 	 * It copies the elements in the range [buffer,buffer + sizeof(double)) into the range beginning at reinterpret_cast<uint8_t*>(&x).
@@ -85,6 +94,15 @@ namespace parsing_utilities
 		return string_utilities::toFloat(string, value) || string.empty();
 	}
 
+	/**
+	 * It checks whether an error occurred (via errno) and whether junk characters
+	 * exist within "string", and returns true if the latter two tests are negative or when the string is empty, false otherwise.
+	 */
+	bool parseFloat(boost::string_ref string, float& value)
+	{
+		return string_utilities::toFloat(string, value) || string.empty();
+	}
+
 	/** 
 	 * The function assumes that the bytes in the buffer are already arranged with the same endianness as the local platform.
 	 * It copies the elements in the range [buffer,buffer + 2) into the range beginning at reinterpret_cast<uint8_t*>(&x).
@@ -163,8 +181,30 @@ namespace parsing_utilities
 
 		return false;
 	}
-	
-	/** 
+
+	/**
+	 * It checks whether an error occurred (via errno) and whether junk characters
+	 * exist within "string", and returns true if the latter two tests are negative or when the string is empty, false otherwise.
+	 */
+	bool parseUInt8(boost::string_ref string, uint8_t& value, int32_t base)
+	{
+		value = 0;
+		if (string.empty())
+		{
+		  return true;
+		}
+
+		uint32_t intermd;
+		if (string_utilities::toUInt32(string, intermd, base) && intermd <= std::numeric_limits<uint8_t>::max())
+		{
+		  value = static_cast<uint8_t>(intermd);
+		  return true;
+		}
+
+		return false;
+	}
+
+	/**
 	 * The function assumes that the bytes in the buffer are already arranged with the same endianness as the local platform.
 	 * It copies the elements in the range [buffer,buffer + 2) into the range beginning at reinterpret_cast<uint8_t*>(&x).
 	 * Recall: data_type *var_name = reinterpret_cast <data_type *>(pointer_variable) converts the pointer type, no return type
@@ -219,6 +259,15 @@ namespace parsing_utilities
 		return string_utilities::toUInt32(string, value, base) || string.empty();
 	}
 
+	/**
+	 * It checks whether an error occurred (via errno) and whether junk characters
+	 * exist within "string", and returns true if the latter two tests are negative or when the string is empty, false otherwise.
+	 */
+	bool parseUInt32(boost::string_ref string, uint32_t& value, int32_t base)
+	{
+		return string_utilities::toUInt32(string, value, base) || string.empty();
+	}
+
 	/**
 	 * The UTC precision in NMEA messages is down to a tenth of a second, naturally in both the without-colon-delimiter 
 	 * and the number-of-seconds-since-midnight formats.
@@ -239,11 +288,64 @@ namespace parsing_utilities
 	double convertDMSToDegrees(double dms)
 	{
 		uint32_t whole_degrees = static_cast<uint32_t>(dms) / 100;
-		double minutes = dms - static_cast<double>(whole_degrees * 100); 
+		double minutes = dms - static_cast<double>(whole_degrees * 100);
 		double degrees = static_cast<double>(whole_degrees) + minutes / 60.0;
 		return degrees;
 	}
-	
+
+	/**
+	 * The digits in front of the decimal point (2 minute digits preceded by 2 or 3 degree digits, receivers
+	 * zero-pad them) and those behind it are each accumulated into one integer, s.t. the only floating point
+	 * operations left are the final scaling and the division by 60. Fields with a sign, an exponent or more
+	 * than 5 digits in front of (or 9 behind) the decimal point are not valid DMS notation and are rejected.
+	 */
+	bool parseDMSDegrees(boost::string_ref dms, double& degrees)
+	{
+		// Scaling factors for up to 9 decimal-minute digits; Septentrio receivers emit at most 7
+		static const double INV_POW10[] = {1.0, 1.0e-1, 1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5, 1.0e-6, 1.0e-7, 1.0e-8, 1.0e-9};
+
+		degrees = 0.0;
+		if (dms.empty())
+		{
+			return true;
+		}
+
+		uint32_t whole = 0;
+		std::size_t i = 0;
+		for (; i < dms.size() && dms[i] != '.'; ++i)
+		{
+			if (dms[i] < '0' || dms[i] > '9' || i >= 5)
+			{
+				return false;
+			}
+			whole = whole * 10 + static_cast<uint32_t>(dms[i] - '0');
+		}
+		if (i < 3) // Fewer than 3 digits cannot hold both degrees and the 2 minute digits
+		{
+			return false;
+		}
+
+		uint32_t fraction = 0;
+		std::size_t n_fraction_digits = 0;
+		if (i < dms.size()) // Skipping the decimal point, the rest are decimal-minute digits
+		{
+			for (++i; i < dms.size(); ++i)
+			{
+				if (dms[i] < '0' || dms[i] > '9' || n_fraction_digits >= 9)
+				{
+					return false;
+				}
+				fraction = fraction * 10 + static_cast<uint32_t>(dms[i] - '0');
+				++n_fraction_digits;
+			}
+		}
+
+		double minutes = static_cast<double>(whole % 100) + static_cast<double>(fraction) * INV_POW10[n_fraction_digits];
+		degrees = static_cast<double>(whole / 100) + minutes / 60.0;
+		return true;
+	}
+
+
 	/**
 	 * Time information (hours, minutes, seconds) is extracted from the given double and augmented
 	 * with the date, which is taken from the current system time on the host computer (i.e. current UTC+some_shift time via time(0)).
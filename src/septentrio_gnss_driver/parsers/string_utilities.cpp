@@ -28,12 +28,24 @@
 //
 // *****************************************************************************
 
-// ROSaic includes 
+// ROSaic includes
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
 // C++ library includes
 #include <cerrno>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+// std::from_chars (C++17) converts locale-independently, straight from the (not NUL-terminated) field views and
+// without the errno round trip of the strtod family. Its floating-point flavor only became available with GCC 11,
+// hence the feature-test macro below rather than a plain C++17 check; older toolchains keep the strtod-based code.
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define STRING_UTILITIES_HAS_FROM_CHARS
+#endif
 
 /**
  * @file string_utilities.cpp
@@ -43,114 +55,206 @@
  
 namespace string_utilities
 {
+	//! Upper bound on the length of a single numeric field; NMEA fields are much shorter than this
+	static const std::size_t MAX_FIELD_LENGTH = 32;
+
 	/**
-	 * It checks whether an error occurred (via errno) and whether junk characters 
-	 * exist within "string", and returns true if the latter two tests are negative and the 
-	 * string is non-empty, false otherwise.
+	 * On C++17 toolchains the conversion is done by std::from_chars directly on the view. Otherwise, since
+	 * "string" is a (not necessarily NUL-terminated) view into the receive buffer, its contents are first
+	 * copied into a small stack buffer before strtod is let loose on them - still free of heap allocations.
+	 * Either way it checks whether an error occurred and whether junk characters exist within "string", and
+	 * returns true if the latter two tests are negative and the string is non-empty, false otherwise.
 	 */
-	bool toDouble(const std::string& string, double& value)
+	bool toDouble(boost::string_ref string, double& value)
 	{
-		if (string.empty())
+		if (string.empty() || string.size() >= MAX_FIELD_LENGTH)
 		{
 			return false;
 		}
-	 
+#if defined(STRING_UTILITIES_HAS_FROM_CHARS)
+		// Unlike strtod, from_chars rejects an explicit plus sign, so strip it for identical acceptance..
+		if (string[0] == '+')
+		{
+			string.remove_prefix(1);
+			if (string.empty() || string[0] == '+' || string[0] == '-')
+			{
+				return false;
+			}
+		}
+		double value_new;
+		std::from_chars_result result = std::from_chars(string.data(), string.data() + string.size(), value_new);
+		if (result.ec != std::errc() || result.ptr != string.data() + string.size())
+		{
+			return false;
+		}
+#else
+		char buffer[MAX_FIELD_LENGTH];
+		memcpy(buffer, string.data(), string.size());
+		buffer[string.size()] = '\0';
+
 		char* end;
 		errno = 0;
 
-		double value_new = std::strtod(string.c_str(), &end);
-		
-		if (errno != 0 || end != string.c_str() + string.length())
+		double value_new = std::strtod(buffer, &end);
+
+		if (errno != 0 || end != buffer + string.size())
 		{
 			return false;
 		}
-	 
+#endif
+
 		value = value_new;
 		return true;
 	}
- 
+
 	/**
-	 * It checks whether an error occurred (via errno) and whether junk characters 
-	 * exist within "string", and returns true if the latter two tests are negative and the 
-	 * string is non-empty, false otherwise.
+	 * On C++17 toolchains the conversion is done by std::from_chars directly on the view. Otherwise, since
+	 * "string" is a (not necessarily NUL-terminated) view into the receive buffer, its contents are first
+	 * copied into a small stack buffer before strtof is let loose on them.
+	 * Either way it checks whether an error occurred and whether junk characters exist within "string", and
+	 * returns true if the latter two tests are negative and the string is non-empty, false otherwise.
 	 */
-	bool toFloat(const std::string& string, float& value)
+	bool toFloat(boost::string_ref string, float& value)
 	{
-		if (string.empty())
+		if (string.empty() || string.size() >= MAX_FIELD_LENGTH)
+		{
+			return false;
+		}
+#if defined(STRING_UTILITIES_HAS_FROM_CHARS)
+		if (string[0] == '+')
+		{
+			string.remove_prefix(1);
+			if (string.empty() || string[0] == '+' || string[0] == '-')
+			{
+				return false;
+			}
+		}
+		float value_new;
+		std::from_chars_result result = std::from_chars(string.data(), string.data() + string.size(), value_new);
+		if (result.ec != std::errc() || result.ptr != string.data() + string.size())
 		{
 			return false;
 		}
-	 
+#else
+		char buffer[MAX_FIELD_LENGTH];
+		memcpy(buffer, string.data(), string.size());
+		buffer[string.size()] = '\0';
+
 		char* end;
 		errno = 0;
-		float value_new = std::strtof(string.c_str(), &end);
-	 
-		if (errno != 0 || end != string.c_str() + string.length())
+		float value_new = std::strtof(buffer, &end);
+
+		if (errno != 0 || end != buffer + string.size())
 		{
 			return false;
 		}
-	 
+#endif
+
 		value = value_new;
 		return true;
 	}
- 
+
 	/**
-	 * It checks whether an error occurred (via errno) and whether junk characters 
-	 * exist within "string", and returns true if the latter two tests are negative and the 
-	 * string is non-empty, false otherwise.
+	 * On C++17 toolchains the conversion is done by std::from_chars directly on the view. Otherwise, since
+	 * "string" is a (not necessarily NUL-terminated) view into the receive buffer, its contents are first
+	 * copied into a small stack buffer before strtol is let loose on them.
+	 * Either way it checks whether an error occurred and whether junk characters exist within "string", and
+	 * returns true if the latter two tests are negative and the string is non-empty, false otherwise.
 	 */
-	bool toInt32(const std::string& string, int32_t& value, int32_t base)
+	bool toInt32(boost::string_ref string, int32_t& value, int32_t base)
 	{
-		if (string.empty())
+		if (string.empty() || string.size() >= MAX_FIELD_LENGTH)
 		{
 			return false;
 		}
- 
+#if defined(STRING_UTILITIES_HAS_FROM_CHARS)
+		if (string[0] == '+')
+		{
+			string.remove_prefix(1);
+			if (string.empty() || string[0] == '+' || string[0] == '-')
+			{
+				return false;
+			}
+		}
+		int32_t value_new;
+		std::from_chars_result result = std::from_chars(string.data(), string.data() + string.size(), value_new, base);
+		if (result.ec != std::errc() || result.ptr != string.data() + string.size())
+		{
+			return false;
+		}
+#else
+		char buffer[MAX_FIELD_LENGTH];
+		memcpy(buffer, string.data(), string.size());
+		buffer[string.size()] = '\0';
+
 		char* end;
 		errno = 0;
-		int64_t value_new = std::strtol(string.c_str(), &end, base);
- 
-		if (errno != 0 || end != string.c_str() + string.length())
+		int64_t value_new = std::strtol(buffer, &end, base);
+
+		if (errno != 0 || end != buffer + string.size())
 		{
 			return false;
 		}
- 
+
 		if (value_new > std::numeric_limits<int32_t>::max() ||
          value_new < std::numeric_limits<int32_t>::min())
 		{
 			return false;
 		}
- 
+#endif
+
 		value = (int32_t) value_new;
 		return true;
 	}
- 
+
 	/**
-	 * It checks whether an error occurred (via errno) and whether junk characters 
-	 * exist within "string", and returns true if the latter two tests are negative and the 
-	 * string is non-empty, false otherwise.
+	 * On C++17 toolchains the conversion is done by std::from_chars directly on the view. Otherwise, since
+	 * "string" is a (not necessarily NUL-terminated) view into the receive buffer, its contents are first
+	 * copied into a small stack buffer before strtol is let loose on them.
+	 * Either way it checks whether an error occurred and whether junk characters exist within "string", and
+	 * returns true if the latter two tests are negative and the string is non-empty, false otherwise.
 	 */
-	bool toUInt32(const std::string& string, uint32_t& value, int32_t base)
+	bool toUInt32(boost::string_ref string, uint32_t& value, int32_t base)
 	{
-		if (string.empty())
+		if (string.empty() || string.size() >= MAX_FIELD_LENGTH)
 		{
 			return false;
 		}
- 
+#if defined(STRING_UTILITIES_HAS_FROM_CHARS)
+		if (string[0] == '+')
+		{
+			string.remove_prefix(1);
+			if (string.empty() || string[0] == '+' || string[0] == '-')
+			{
+				return false;
+			}
+		}
+		uint32_t value_new;
+		std::from_chars_result result = std::from_chars(string.data(), string.data() + string.size(), value_new, base);
+		if (result.ec != std::errc() || result.ptr != string.data() + string.size())
+		{
+			return false;
+		}
+#else
+		char buffer[MAX_FIELD_LENGTH];
+		memcpy(buffer, string.data(), string.size());
+		buffer[string.size()] = '\0';
+
 		char* end;
 		errno = 0;
-		int64_t value_new = std::strtol(string.c_str(), &end, base);
- 
-		if (errno != 0 || end != string.c_str() + string.length())
+		int64_t value_new = std::strtol(buffer, &end, base);
+
+		if (errno != 0 || end != buffer + string.size())
 		{
 			return false;
 		}
- 
+
 		if (value_new > std::numeric_limits<uint32_t>::max() || value_new < 0)
 		{
 			return false;
 		}
- 
+#endif
+
 		value = (uint32_t) value_new;
 		return true;
 	}